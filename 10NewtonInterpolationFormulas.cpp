@@ -4,81 +4,131 @@
 #include <cmath>
 using namespace std;
 
+// Weights of h·f'(x₀) = Σ wₘ Δᵐy₀, wₘ = s(m, 1)/m! = (-1)^(m-1)/m, built by the compiler
+// (31ConstexprTables.cpp generates the tables for derivatives of any order)
+template <int M>
+struct ForwardDerivativeWeights {
+    double w[M + 1];
+
+    constexpr ForwardDerivativeWeights() : w() {
+        for (int m = 1; m <= M; m++) w[m] = (m % 2 ? 1.0 : -1.0) / m;
+    }
+};
+
 class NumericalDifferentiation {
 private:
     vector<double> x, y;
-    int n;
+    int n = 0;
+    
+    // Only two diagonals of the forward difference table are kept, so memory is O(n):
+    // top[j]  = Δʲy₀          (the entries used by Newton's forward formula)
+    // tail[j] = Δʲy_{n-1-j}   (the last entry of each column = ∇ʲy_{n-1}, needed to extend the table)
+    vector<double> top, tail;
+    int requestedOrder = 0;  // highest difference order asked for, even before enough samples exist
+    int rebuilds = 0;        // full O(n·order) recomputations; zero when every sample was appended incrementally
     
 public:
+    // O(requestedOrder): appending yₙ extends every maintained column by one entry and,
+    // while n - 1 <= requestedOrder, opens the next column with its single entry Δⁿ⁻¹y₀
     void addPoint(double xi, double yi) {
         x.push_back(xi);
         y.push_back(yi);
         n = x.size();
-    }
-    
-    vector<vector<double>> computeDifferenceTable() {
-        vector<vector<double>> table(n, vector<double>(n, 0));
         
-        // First column is y values
-        for (int i = 0; i < n; i++) {
-            table[i][0] = y[i];
+        int orders = min(n - 1, requestedOrder);
+        tail.resize(orders + 1);
+        double carry = yi;  // carry = Δʲy_{n-1-j} of the new last row
+        for (int j = 0; j <= orders; j++) {
+            double old = tail[j];
+            tail[j] = carry;
+            carry -= old;
         }
-        
-        // Compute forward differences
-        for (int j = 1; j < n; j++) {
+        if (n - 1 <= requestedOrder) {
+            top.push_back(tail[n - 1]);
+        }
+    }
+    
+    // Records the order for later samples; differences over samples already stored are only
+    // recomputed (in place over one O(n) work array) when the order is raised after the fact
+    void ensureOrder(int order) {
+        requestedOrder = max(requestedOrder, order);
+        int orders = min(requestedOrder, n - 1);
+        if (n == 0 || static_cast<int>(top.size()) >= orders + 1) return;
+        
+        rebuilds++;
+        vector<double> work = y;
+        top.assign(orders + 1, 0);
+        tail.assign(orders + 1, 0);
+        top[0] = work[0];
+        tail[0] = work[n - 1];
+        for (int j = 1; j <= orders; j++) {
             for (int i = 0; i < n - j; i++) {
-                table[i][j] = table[i+1][j-1] - table[i][j-1];
+                work[i] = work[i+1] - work[i];
             }
+            top[j] = work[0];
+            tail[j] = work[n - 1 - j];
         }
-        
-        return table;
     }
     
-    void printDifferenceTable(const vector<vector<double>>& table) {
+    int tableRebuilds() const { return rebuilds; }
+    
+    // Backward differences ∇ʲyₙ₋₁ for j = 0..order, straight from the maintained tail
+    vector<double> backwardDifferences(int order) {
+        ensureOrder(order);
+        return vector<double>(tail.begin(), tail.begin() + min(order, n - 1) + 1);
+    }
+    
+    // Returns Δʲy₀ for j = 0..order
+    vector<double> forwardDifferences(int order) {
+        ensureOrder(order);
+        return vector<double>(top.begin(), top.begin() + min(order, n - 1) + 1);
+    }
+    
+    void printDifferenceTable(int order) {
+        order = min(order, n - 1);
         cout << "=== FORWARD DIFFERENCE TABLE ===" << endl;
         cout << setw(6) << "x" << setw(10) << "y" << setw(10) << "Δy" 
              << setw(10) << "Δ²y" << setw(10) << "Δ³y" << setw(10) << "Δ⁴y" << endl;
         cout << string(60, '-') << endl;
         
+        // Each row i is the diagonal Δʲyᵢ, rebuilt in a scratch array so printing needs no n×n table
+        vector<double> work(n);
         for (int i = 0; i < n; i++) {
             cout << setw(6) << fixed << setprecision(1) << x[i];
-            for (int j = 0; j < n - i; j++) {
-                cout << setw(10) << setprecision(4) << table[i][j];
+            int m = n - i;
+            copy(y.begin() + i, y.end(), work.begin());
+            for (int j = 0; j < m && j <= order; j++) {
+                cout << setw(10) << setprecision(4) << work[0];
+                for (int k = 0; k < m - j - 1; k++) {
+                    work[k] = work[k+1] - work[k];
+                }
             }
             cout << endl;
         }
         cout << endl;
     }
     
-    double newtonForwardDerivative(double x_val, const vector<vector<double>>& table) {
+    static constexpr int derivativeTerms = 4;
+    static constexpr ForwardDerivativeWeights<derivativeTerms> weights{};
+
+    double newtonForwardDerivative(double x_val) {
         // Find the interval containing x_val
         int index = 0;
         double h = x[1] - x[0];  // Assuming equal spacing
+        vector<double> delta = forwardDifferences(derivativeTerms);
         
         // For Newton's forward formula: f'(x₀) ≈ (1/h)[Δy₀ - (1/2)Δ²y₀ + (1/3)Δ³y₀ - ...]
         cout << "=== NEWTON'S FORWARD DIFFERENTIATION FORMULA ===" << endl;
         cout << "For equally spaced points with h = " << h << endl;
         cout << "f'(x₀) ≈ (1/h)[Δy₀ - (1/2)Δ²y₀ + (1/3)Δ³y₀ - (1/4)Δ⁴y₀ + ...]" << endl << endl;
         
-        double derivative = table[0][1]/h;  // First term: Δy₀/h
-        cout << "First term: Δy₀/h = " << table[0][1] << "/" << h << " = " << derivative << endl;
-        
-        if (n > 2) {
-            double term2 = -0.5 * table[0][2]/h;
-            derivative += term2;
-            cout << "Second term: -(1/2)Δ²y₀/h = -0.5 × " << table[0][2] << "/" << h << " = " << term2 << endl;
-        }
-        
-        if (n > 3) {
-            double term3 = (1.0/3.0) * table[0][3]/h;
-            derivative += term3;
-            cout << "Third term: (1/3)Δ³y₀/h = (1/3) × " << table[0][3] << "/" << h << " = " << term3 << endl;
-        }
-        
-        if (n > 4) {
-            double term4 = -0.25 * table[0][4]/h;
-            derivative += term4;
-            cout << "Fourth term: -(1/4)Δ⁴y₀/h = -0.25 × " << table[0][4] << "/" << h << " = " << term4 << endl;
+        // One table lookup per term; raising derivativeTerms extends the series
+        double derivative = 0;
+        for (int m = 1; m <= derivativeTerms && m < n; m++) {
+            double term = weights.w[m] * delta[m] / h;
+            derivative += term;
+            cout << "Term " << m << ": w" << m << "·Δ^" << m << "y₀/h = " << weights.w[m] << " × " << delta[m]
+                 << "/" << h << " = " << term << endl;
         }
         
         return derivative;
@@ -103,11 +153,10 @@ public:
         }
         cout << endl;
         
-        auto table = computeDifferenceTable();
-        printDifferenceTable(table);
+        printDifferenceTable(4);
         
         // Newton's forward differentiation at x₀
-        double forward_deriv = newtonForwardDerivative(x[0], table);
+        double forward_deriv = newtonForwardDerivative(x[0]);
         cout << "\nNewton's forward derivative at x₀ = " << x[0] << ": " << forward_deriv << endl;
         
         // Central difference at middle point
@@ -117,7 +166,7 @@ public:
         
         // Backward difference at last point
         double h = x[1] - x[0];
-        double backward_deriv = (y[n-1] - y[n-2]) / h;
+        double backward_deriv = backwardDifferences(1)[1] / h;  // ∇yₙ is kept up to date by addPoint
         cout << "Backward difference at x = " << x[n-1] << ": " << backward_deriv << endl;
     }
 };
@@ -140,6 +189,39 @@ int main() {
     cout << "f'(0) = 2, f'(2) = 6, f'(4) = 10" << endl;
     cout << "Compare with numerical results above." << endl;
     
+    cout << "\n=== LARGE DATA SETS ===" << endl;
+    // Only the diagonals up to the requested order are stored, so memory stays O(n)
+    // and each appended sample updates them in O(order) time
+    NumericalDifferentiation large;
+    large.ensureOrder(4);
+    int samples = 100000;
+    for (int i = 0; i < samples; i++) {
+        double xi = i * 1e-3;
+        large.addPoint(xi, xi*xi + 2*xi + 1);
+    }
+    vector<double> delta = large.forwardDifferences(4);
+    vector<double> nabla = large.backwardDifferences(4);
+    cout << "Samples: " << samples << ", h = 0.001" << endl;
+    cout << "Δy₀ = " << delta[1] << ", Δ²y₀ = " << scientific << delta[2]
+         << " (exact 2h² = 2e-06), Δ³y₀ = " << delta[3] << fixed << endl;
+    cout << "∇y at x = " << (samples - 1) * 1e-3 << ": " << nabla[1]
+         << " (exact 2hx + 2h - h² = " << 2e-3 * (samples - 1) * 1e-3 + 2e-3 - 1e-6 << ")" << endl;
+    
+    // Check: every sample went through addPoint's O(order) update, and the result matches
+    // a table rebuilt from scratch over the same samples
+    NumericalDifferentiation rebuilt;
+    for (int i = 0; i < samples; i++) {
+        double xi = i * 1e-3;
+        rebuilt.addPoint(xi, xi*xi + 2*xi + 1);
+    }
+    vector<double> reference = rebuilt.backwardDifferences(4);
+    double worst = 0;
+    for (int j = 0; j <= 4; j++) worst = max(worst, fabs(reference[j] - nabla[j]));
+    cout << "Incremental rebuilds: " << large.tableRebuilds()
+         << " (from-scratch table: " << rebuilt.tableRebuilds() << " rebuild)"
+         << ", max |∇ʲ incremental - ∇ʲ rebuilt| = " << scientific << worst << fixed
+         << (large.tableRebuilds() == 0 && worst < 1e-9 ? "  OK" : "  MISMATCH") << endl;
+    
     cout << "\n=== APPLICATIONS ===" << endl;
     cout << "Newton's interpolation formulas for differentiation are used when:" << endl;
     cout << "1. Analytical derivative is difficult to compute" << endl;
@@ -24,6 +24,9 @@ Final Solution: y = (1/2)e^x + (1/2)e^(-x) = (1/2)(e^x + e^(-x))
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include <vector>
+#include <functional>
+#include <algorithm>
 using namespace std;
 
 // Analytical solution
@@ -31,24 +34,141 @@ double analyticalSolution(double x) {
     return 0.5 * (exp(x) + exp(-x));
 }
 
-// Numerical solution using 4th order Runge-Kutta
-double rungeKutta4(double x0, double y0, double x, double h) {
-    int n = static_cast<int>((x - x0) / h);
-    double y = y0;
-    double xi = x0;
+// dy/dx = -y + e^x
+double f(double x, double y) {
+    return -y + exp(x);
+}
+
+/*
+Dense output: instead of re-integrating from x0 for every output point, integrate once and, for each step
+[xₙ, xₙ₊₁], interpolate with the cubic Hermite polynomial through (yₙ, y'ₙ) and (yₙ₊₁, y'ₙ₊₁):
+y(xₙ + θh) ≈ h₀₀(θ)yₙ + h₁₀(θ)h·y'ₙ + h₀₁(θ)yₙ₊₁ + h₁₁(θ)h·y'ₙ₊₁
+h₀₀ = 2θ³ - 3θ² + 1, h₁₀ = θ³ - 2θ² + θ, h₀₁ = -2θ³ + 3θ², h₁₁ = θ³ - θ²
+The slope y'ₙ₊₁ = f(xₙ₊₁, yₙ₊₁) is exactly k₁ of the next RK4 step, so the interpolant costs no extra evaluations.
+Events g(x, y) = 0 are detected by a sign change of g across a step and located on the interpolant. All crossings
+inside a step are located first and dispatched in order of x; a terminal event ends the integration there, so
+crossings after it in the same step are never reported.
+*/
+struct HermiteSegment {
+    double x0, y0, f0, x1, y1, f1;
     
-    for (int i = 0; i < n; i++) {
-        double k1 = h * (-y + exp(xi));
-        double k2 = h * (-(y + k1/2) + exp(xi + h/2));
-        double k3 = h * (-(y + k2/2) + exp(xi + h/2));
-        double k4 = h * (-(y + k3) + exp(xi + h));
-        
-        y = y + (k1 + 2*k2 + 2*k3 + k4) / 6;
-        xi = xi + h;
+    double operator()(double x) const {
+        double h = x1 - x0;
+        double t = (x - x0) / h;
+        double t2 = t*t, t3 = t2*t;
+        return (2*t3 - 3*t2 + 1)*y0 + (t3 - 2*t2 + t)*h*f0 + (-2*t3 + 3*t2)*y1 + (t3 - t2)*h*f1;
     }
+};
+
+struct Event {
+    function<double(double, double)> g;              // event when g(x, y) changes sign
+    function<bool(double, double, int)> onEvent;     // (x, y, direction); return true to stop integrating
+};
+
+struct Crossing {
+    double x;
+    size_t event;
+    int direction;
+};
+
+class DenseRungeKutta4 {
+private:
+    long long evaluations = 0;
     
-    return y;
-}
+    double rhs(double x, double y) {
+        evaluations++;
+        return f(x, y);
+    }
+    
+    // Root of g along the segment by the Illinois (modified regula falsi) method
+    double locateEvent(const Event& e, const HermiteSegment& seg, double gA, double gB) {
+        double a = seg.x0, b = seg.x1;
+        int side = 0;
+        for (int iter = 0; iter < 60 && b - a > 1e-14 * max(1.0, abs(b)); iter++) {
+            double c = (a * gB - b * gA) / (gB - gA);
+            double gC = e.g(c, seg(c));
+            if (gC * gB > 0) {
+                b = c; gB = gC;
+                if (side == -1) gA /= 2;
+                side = -1;
+            } else if (gA * gC > 0) {
+                a = c; gA = gC;
+                if (side == 1) gB /= 2;
+                side = 1;
+            } else {
+                return c;
+            }
+        }
+        return (a * gB - b * gA) / (gB - gA);
+    }
+    
+public:
+    long long functionEvaluations() const { return evaluations; }
+    
+    // Integrates once from x0 to x_final, calling onOutput(x, y) at each of the (ascending) output times
+    void integrate(double x0, double y0, double x_final, double h, const vector<double>& outputTimes,
+                   const function<void(double, double)>& onOutput, const vector<Event>& events = {}) {
+        int steps = static_cast<int>(ceil((x_final - x0) / h - 1e-9));
+        size_t next = 0;
+        
+        double x = x0, y = y0;
+        double fx = rhs(x, y);
+        vector<double> gPrev;
+        for (const auto& e : events) gPrev.push_back(e.g(x, y));
+        vector<Crossing> crossings;
+        
+        while (next < outputTimes.size() && outputTimes[next] <= x0) {
+            onOutput(outputTimes[next++], y0);
+        }
+        
+        for (int i = 0; i < steps; i++) {
+            double x1 = (i == steps - 1) ? x_final : x0 + (i + 1) * h;
+            double hs = x1 - x;
+            
+            double k1 = hs * fx;
+            double k2 = hs * rhs(x + hs/2, y + k1/2);
+            double k3 = hs * rhs(x + hs/2, y + k2/2);
+            double k4 = hs * rhs(x + hs, y + k3);
+            double y1 = y + (k1 + 2*k2 + 2*k3 + k4) / 6;
+            double f1 = rhs(x1, y1);  // reused as k₁ of the next step
+            
+            HermiteSegment seg = {x, y, fx, x1, y1, f1};
+            
+            // Locate every crossing in this step, then report them in order up to the first terminal one
+            crossings.clear();
+            for (size_t k = 0; k < events.size(); k++) {
+                double gNew = events[k].g(x1, y1);
+                if (gPrev[k] * gNew < 0 || (gNew == 0 && gPrev[k] != 0)) {
+                    double xe = locateEvent(events[k], seg, gPrev[k], gNew);
+                    crossings.push_back({xe, k, gNew > gPrev[k] ? 1 : -1});
+                }
+                gPrev[k] = gNew;
+            }
+            stable_sort(crossings.begin(), crossings.end(),
+                        [](const Crossing& a, const Crossing& b) { return a.x < b.x; });
+            
+            double stopAt = x1;
+            bool stop = false;
+            for (const Crossing& c : crossings) {
+                if (events[c.event].onEvent(c.x, seg(c.x), c.direction)) {
+                    stopAt = c.x;
+                    stop = true;
+                    break;
+                }
+            }
+            
+            while (next < outputTimes.size() && outputTimes[next] <= stopAt) {
+                double xo = outputTimes[next++];
+                onOutput(xo, xo == x1 ? y1 : seg(xo));
+            }
+            
+            if (stop) return;
+            x = x1;
+            y = y1;
+            fx = f1;
+        }
+    }
+};
 
 int main() {
     double x0 = 0.0, y0 = 1.0;
@@ -62,13 +182,67 @@ int main() {
     cout << "x\t\tAnalytical\tNumerical\tError" << endl;
     cout << "--------------------------------------------" << endl;
     
-    for (double x = x0; x <= x_final; x += 0.2) {
+    // One pass of the integrator produces every output point
+    vector<double> outputs;
+    for (int i = 0; x0 + i * 0.2 <= x_final + 1e-12; i++) {
+        outputs.push_back(x0 + i * 0.2);
+    }
+    
+    DenseRungeKutta4 integrator;
+    integrator.integrate(x0, y0, x_final, h, outputs, [](double x, double numerical) {
         double analytical = analyticalSolution(x);
-        double numerical = rungeKutta4(x0, y0, x, h);
         double error = abs(analytical - numerical);
         
         cout << x << "\t\t" << analytical << "\t" << numerical << "\t" << error << endl;
+    });
+    
+    // Dense sampling at off-grid times costs no more than the integration itself
+    cout << "\n=== DENSE OUTPUT ===" << endl;
+    int m = 1000;
+    vector<double> dense(m);
+    for (int i = 0; i < m; i++) dense[i] = x_final * (i + 0.5) / m;
+    
+    double maxError = 0;
+    DenseRungeKutta4 sampler;
+    sampler.integrate(x0, y0, x_final, h, dense, [&maxError](double x, double y) {
+        maxError = max(maxError, abs(y - analyticalSolution(x)));
+    });
+    long long rerunEvaluations = 0;
+    for (double x : dense) rerunEvaluations += 4LL * static_cast<int>((x - x0) / h);
+    cout << "Output points: " << m << " (off the step grid)" << endl;
+    cout << "Max error of Hermite interpolant: " << scientific << setprecision(3) << maxError << endl;
+    cout << "RHS evaluations, single pass: " << sampler.functionEvaluations() << endl;
+    cout << "RHS evaluations, re-integrating from x0 per point: " << rerunEvaluations << endl;
+    
+    // Event detection: first time the solution reaches y = 1.3
+    cout << "\n=== EVENT DETECTION ===" << endl;
+    Event crossing;
+    crossing.g = [](double, double y) { return y - 1.3; };
+    crossing.onEvent = [](double x, double y, int direction) {
+        cout << fixed << setprecision(8);
+        cout << "y = " << y << " reached at x = " << x << (direction > 0 ? " (rising)" : " (falling)") << endl;
+        cout << "Exact crossing: x = acosh(1.3) = " << acosh(1.3) << endl;
+        return true;
+    };
+    DenseRungeKutta4 detector;
+    detector.integrate(x0, y0, x_final, h, {}, [](double, double) {}, {crossing});
+    
+    // Several crossings inside one long step are reported in order of x, whatever order the events were given in,
+    // and nothing after the terminal one is reported
+    cout << "\nOne step of h = 0.5 over [0.5, 1] crosses y = 1.2, 1.3 (terminal) and 1.4:" << endl;
+    vector<Event> levels;
+    for (double level : {1.4, 1.3, 1.2}) {
+        Event e;
+        e.g = [level](double, double y) { return y - level; };
+        e.onEvent = [level](double x, double, int) {
+            cout << "  y = " << setprecision(1) << level << " at x = " << setprecision(8) << x
+                 << " (exact " << acosh(level) << ")" << (level == 1.3 ? ", stopping" : "") << endl;
+            return level == 1.3;
+        };
+        levels.push_back(e);
     }
+    DenseRungeKutta4 ordered;
+    ordered.integrate(x0, y0, x_final, 0.5, {}, [](double, double) {}, levels);
     
     return 0;
-}
\ No newline at end of file
+}
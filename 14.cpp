@@ -28,51 +28,286 @@ For l = d: π = 2/P(crossing)
 #include <random>
 #include <cmath>
 #include <iomanip>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <functional>
+#include <string>
 using namespace std;
 
-double buffonsNeedle(int numTrials, double needleLength, double lineSpacing) {
-    random_device rd;
-    mt19937 gen(rd());
+/*
+Vectorized trials without sin
+The needle direction only enters through sin θ. Drawing a point (u, v) uniformly in the unit square and keeping it
+only if u² + v² ≤ 1 gives a uniform direction θ ∈ [0, π/2] with sin θ = v / √(u² + v²) (acceptance rate π/4);
+|sin θ| has the same distribution on [0, π/2] as on [0, π]. With x the centre-to-line distance, the crossing test
+x ≤ (l/2) sin θ becomes, after squaring both non-negative sides,
+x²(u² + v²) ≤ (l/2)² v²
+so a trial costs a few multiplies and two comparisons. Eight independent xoshiro256+ generators run in lockstep in
+separate arrays, so the compiler keeps the generator, the tests and the counters in SIMD registers; accepted trials
+and crossings are summed from the comparison masks.
+*/
+class VectorNeedleKernel {
+private:
+    static const int lanes = 8;
+    uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];  // xoshiro256+ state, one generator per lane
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Random bits placed in the mantissa of 1.0 give a double in [1, 2); a bit pattern copy vectorizes on every
+    // SIMD level, unlike the 64-bit integer to double conversion, which needs AVX-512
+    static double unitFromMantissa(uint64_t mantissa) {
+        uint64_t bits = 0x3FF0000000000000ull | mantissa;
+        double value;
+        memcpy(&value, &bits, 8);
+        return value - 1.0;
+    }
+
+public:
+    explicit VectorNeedleKernel(uint64_t seed) {
+        for (int j = 0; j < lanes; j++) {
+            s0[j] = splitmix64(seed);
+            s1[j] = splitmix64(seed);
+            s2[j] = splitmix64(seed);
+            s3[j] = splitmix64(seed);
+        }
+    }
+
+    // Runs candidate batches until at least minTrials needles were accepted; returns {trials, crossings}
+    pair<uint64_t, uint64_t> run(uint64_t minTrials, double needleLength, double lineSpacing) {
+        const double halfLength2 = (needleLength / 2) * (needleLength / 2);
+        const double halfSpacing = lineSpacing / 2;
+        uint64_t accepted[lanes] = {}, crossed[lanes] = {};
+        uint64_t trials = 0;
+        while (trials < minTrials) {
+            // Rounds before the next check: never more candidates than trials still missing, at most 64 rounds
+            uint64_t batches = max<uint64_t>(1, min<uint64_t>(64, (minTrials - trials) / lanes));
+            for (uint64_t b = 0; b < batches; b++) {
+                for (int j = 0; j < lanes; j++) {
+                    // Two xoshiro256+ outputs: (u, v) from the halves of the first, x from the second
+                    uint64_t a = s0[j] + s3[j];
+                    uint64_t t = s1[j] << 17;
+                    s2[j] ^= s0[j]; s3[j] ^= s1[j]; s1[j] ^= s2[j]; s0[j] ^= s3[j];
+                    s2[j] ^= t; s3[j] = (s3[j] << 45) | (s3[j] >> 19);
+                    uint64_t c = s0[j] + s3[j];
+                    t = s1[j] << 17;
+                    s2[j] ^= s0[j]; s3[j] ^= s1[j]; s1[j] ^= s2[j]; s0[j] ^= s3[j];
+                    s2[j] ^= t; s3[j] = (s3[j] << 45) | (s3[j] >> 19);
+
+                    double u = unitFromMantissa((a >> 32) << 20);
+                    double v = unitFromMantissa((a & 0xFFFFFFFFu) << 20);
+                    double x = unitFromMantissa(c >> 12) * halfSpacing;
+                    double r2 = u*u + v*v;
+                    // Bitwise & instead of && keeps the loop free of branches
+                    uint64_t inDisk = (r2 <= 1.0) & (r2 > 0.0);
+                    accepted[j] += inDisk;
+                    crossed[j] += inDisk & (x*x*r2 <= halfLength2*v*v);
+                }
+            }
+            trials = 0;
+            for (int j = 0; j < lanes; j++) trials += accepted[j];
+        }
+        uint64_t crossings = 0;
+        for (int j = 0; j < lanes; j++) crossings += crossed[j];
+        return {trials, crossings};
+    }
+};
+
+// Scalar version with uniform_real_distribution and sin, for comparison
+double buffonsNeedleScalar(long long numTrials, double needleLength, double lineSpacing, uint64_t seed) {
+    mt19937 gen(seed);
     uniform_real_distribution<double> angleDist(0.0, M_PI);
     uniform_real_distribution<double> positionDist(0.0, lineSpacing/2);
-    
-    int crossings = 0;
-    
-    for (int i = 0; i < numTrials; i++) {
+    long long crossings = 0;
+    for (long long i = 0; i < numTrials; i++) {
         double angle = angleDist(gen);
         double position = positionDist(gen);
-        
-        // Check if needle crosses a line
-        if (position <= (needleLength/2) * sin(angle)) {
-            crossings++;
-        }
+        if (position <= (needleLength/2) * sin(angle)) crossings++;
     }
-    
     double probability = static_cast<double>(crossings) / numTrials;
     return (2 * needleLength) / (probability * lineSpacing);
 }
 
+// The trial count may be exceeded by at most lanes - 1 needles from the last round
+double buffonsNeedle(long long numTrials, double needleLength, double lineSpacing) {
+    random_device rd;
+    uint64_t seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    VectorNeedleKernel kernel(seed);
+    pair<uint64_t, uint64_t> result = kernel.run(numTrials, needleLength, lineSpacing);
+    double probability = static_cast<double>(result.second) / result.first;
+    return (2 * needleLength) / (probability * lineSpacing);
+}
+
+/*
+Progressive (anytime) estimation
+Batches of trials are merged into running statistics (Chan et al.: counts, mean and sum of squared deviations add
+exactly, so no sample is ever discarded). For crossings, p̂ = crossings / trials and Var(p̂) = p̂(1 - p̂)/n.
+π̂ = 2l/(p̂d), and by the delta method its standard error is π̂·se(p̂)/p̂; the confidence interval is π̂ ± z·se.
+The run stops when the half-width reaches the absolute or relative target, or when the time budget is spent.
+Batch sizes grow geometrically, but once the half-width is known the next batch is sized from
+n_needed = n·(halfWidth / target)², so the sample count lands close to what the accuracy requires.
+*/
+struct StoppingRule {
+    double absoluteError = 0;       // target half-width of the confidence interval (0 = unused)
+    double relativeError = 0;       // target half-width / |estimate| (0 = unused)
+    double timeBudget = 0;          // seconds (0 = unlimited)
+    long long maxTrials = 0;        // 0 = unlimited
+    double confidence = 0.95;
+};
+
+struct ProgressReport {
+    long long trials;
+    double estimate, halfWidth, seconds;
+};
+
+class ProgressiveNeedleEstimator {
+private:
+    VectorNeedleKernel kernel;
+    double needleLength, lineSpacing;
+    long long n = 0;            // trials so far
+    double mean = 0, m2 = 0;    // running mean and sum of squared deviations of the crossing indicator
+
+    // z with P(|Z| ≤ z) = confidence, by bisection on erfc
+    static double zValue(double confidence) {
+        double lo = 0, hi = 10;
+        for (int i = 0; i < 100; i++) {
+            double mid = 0.5 * (lo + hi);
+            if (erfc(mid / sqrt(2.0)) > 1 - confidence) lo = mid;
+            else hi = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    // Merge a batch of nb trials with k crossings (batch mean k/nb, batch M2 = k(1 - k/nb))
+    void merge(long long nb, long long k) {
+        double meanB = static_cast<double>(k) / nb;
+        double m2B = k * (1 - meanB);
+        double delta = meanB - mean;
+        long long total = n + nb;
+        mean += delta * nb / total;
+        m2 += m2B + delta * delta * static_cast<double>(n) * nb / total;
+        n = total;
+    }
+
+public:
+    string stopReason;
+
+    ProgressiveNeedleEstimator(double l, double d, uint64_t seed) : kernel(seed), needleLength(l), lineSpacing(d) {}
+
+    double estimate() const { return 2 * needleLength / (mean * lineSpacing); }
+
+    double standardError() const {
+        if (n < 2 || mean <= 0) return INFINITY;
+        double sep = sqrt(m2 / (n - 1) / n);
+        return estimate() * sep / mean;
+    }
+
+    long long trials() const { return n; }
+
+    // Runs until the rule is satisfied; onBatch(report) is called after every batch
+    void run(const StoppingRule& rule, const function<void(const ProgressReport&)>& onBatch = nullptr) {
+        auto start = chrono::steady_clock::now();
+        double z = zValue(rule.confidence);
+        long long batch = 4096;
+        const long long minTrials = 10000;   // below this the normal approximation is not trusted
+        while (true) {
+            if (rule.maxTrials > 0) batch = min(batch, rule.maxTrials - n);
+            pair<uint64_t, uint64_t> counts = kernel.run(batch, needleLength, lineSpacing);
+            merge(counts.first, counts.second);
+
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            double halfWidth = z * standardError();
+            if (onBatch) onBatch({n, estimate(), halfWidth, seconds});
+
+            double target = INFINITY;
+            if (rule.absoluteError > 0) target = rule.absoluteError;
+            if (rule.relativeError > 0) target = min(target, rule.relativeError * abs(estimate()));
+            if (n >= minTrials && halfWidth <= target) {
+                stopReason = "accuracy target reached";
+                return;
+            }
+            if (rule.timeBudget > 0 && seconds >= rule.timeBudget) {
+                stopReason = "time budget spent";
+                return;
+            }
+            if (rule.maxTrials > 0 && n >= rule.maxTrials) {
+                stopReason = "trial limit reached";
+                return;
+            }
+
+            // Next batch: geometric growth, capped by the predicted remaining need and by the remaining time
+            long long next = batch * 2;
+            if (n >= minTrials && isfinite(target)) {
+                double needed = n * (halfWidth / target) * (halfWidth / target) - n;
+                next = min(next, max(4096LL, static_cast<long long>(needed * 1.02) + 1));
+            }
+            if (rule.timeBudget > 0) {
+                double rate = n / max(seconds, 1e-9);
+                next = min(next, max(4096LL, static_cast<long long>(rate * (rule.timeBudget - seconds)) + 1));
+            }
+            batch = next;
+        }
+    }
+};
+
 int main() {
     double l = 1.0;  // needle length
     double d = 1.0;  // line spacing (l ≤ d)
-    
+
     cout << fixed << setprecision(6);
     cout << "Buffon's Needle Problem - Estimating π" << endl;
     cout << "Needle length: " << l << endl;
     cout << "Line spacing: " << d << endl << endl;
-    
-    vector<int> trials = {1000, 10000, 100000, 1000000};
-    
-    for (int numTrials : trials) {
-        double piEstimate = buffonsNeedle(numTrials, l, d);
-        double error = abs(piEstimate - M_PI);
-        
-        cout << "Trials: " << setw(8) << numTrials 
-             << " | π estimate: " << setw(8) << piEstimate 
-             << " | Error: " << setw(8) << error << endl;
-    }
-    
+
+    // One progressive run instead of independent reruns: every batch adds to the same running statistics
+    random_device rd;
+    ProgressiveNeedleEstimator estimator(l, d, (static_cast<uint64_t>(rd()) << 32) | rd());
+    StoppingRule rule;
+    rule.absoluteError = 5e-4;
+    rule.timeBudget = 2.0;
+    cout << "Target: 95% confidence half-width ≤ 5e-4, time budget 2 s" << endl;
+    cout << setw(14) << "trials" << setw(12) << "π estimate" << setw(14) << "± (95%)" << setw(12) << "error"
+         << setw(12) << "time (s)" << endl;
+    estimator.run(rule, [](const ProgressReport& r) {
+        cout << setw(14) << r.trials << setw(12) << setprecision(6) << r.estimate << setw(14) << r.halfWidth
+             << setw(12) << abs(r.estimate - M_PI) << setw(12) << setprecision(3) << r.seconds << endl;
+    });
+    cout << "Stopped: " << estimator.stopReason << " after " << estimator.trials() << " trials" << endl;
+
+    // Relative target with a tight budget: the budget ends the run first
+    ProgressiveNeedleEstimator budgeted(l, d, 2024);
+    StoppingRule tight;
+    tight.relativeError = 1e-6;
+    tight.timeBudget = 0.25;
+    budgeted.run(tight);
+    cout << "\nTarget relative half-width 1e-6 within 0.25 s: " << budgeted.stopReason << " after "
+         << budgeted.trials() << " trials, π ≈ " << setprecision(6) << budgeted.estimate() << " ± "
+         << 1.959964 * budgeted.standardError() << endl;
+
     cout << "\nActual π = " << M_PI << endl;
-    
+
+    cout << "\n=== THROUGHPUT (10^7 trials, one core) ===" << endl;
+    const long long n = 10000000;
+    auto start = chrono::steady_clock::now();
+    double scalarEstimate = buffonsNeedleScalar(n, l, d, 12345);
+    double scalarTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    VectorNeedleKernel kernel(12345);
+    pair<uint64_t, uint64_t> counts = kernel.run(n, l, d);
+    double vectorTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double vectorEstimate = 2 * l / (static_cast<double>(counts.second) / counts.first * d);
+
+    cout << "mt19937 + sin:            " << setw(8) << setprecision(3) << scalarTime / n * 1e9 << " ns/trial, π ≈ "
+         << setprecision(6) << scalarEstimate << endl;
+    cout << "vector kernel, no sin:    " << setw(8) << setprecision(3) << vectorTime / counts.first * 1e9
+         << " ns/trial, π ≈ " << setprecision(6) << vectorEstimate << endl;
+    cout << "Speedup: " << setprecision(1) << (scalarTime / n) / (vectorTime / counts.first) << "x" << endl;
+
     return 0;
-}
\ No newline at end of file
+}
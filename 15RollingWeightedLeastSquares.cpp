@@ -0,0 +1,362 @@
+/*Rolling (sliding-window) weighted least squares keeps the fit y = a + bx up to date as samples arrive and leave,
+without rebuilding the normal equations. Instead of the raw sums Σw, Σwx, Σwx², ... (which lose precision through
+cancellation) it keeps weighted means and centred co-moments, updated West/Welford style:
+
+Adding (x, y, w):
+W' = W + w
+x̄' = x̄ + (w/W')(x - x̄)        ȳ' = ȳ + (w/W')(y - ȳ)
+Sxx' = Sxx + w(x - x̄)(x - x̄')   Sxy' = Sxy + w(x - x̄)(y - ȳ')   Syy' = Syy + w(y - ȳ)(y - ȳ')
+
+Removing (x, y, w) is the exact inverse (downdating):
+W' = W - w
+x̄' = x̄ - (w/W')(x - x̄)        ȳ' = ȳ - (w/W')(y - ȳ)
+Sxx' = Sxx - w(x - x̄')(x - x̄)   Sxy' = Sxy - w(x - x̄')(y - ȳ)   Syy' = Syy - w(y - ȳ')(y - ȳ)
+
+Fit: b = Sxy/Sxx, a = ȳ - b·x̄, weighted SSE = Syy - Sxy²/Sxx
+
+Every add and remove is O(1). Rounding drift from repeated downdating is removed by re-anchoring: after a fixed number
+of removals the moments are recomputed exactly from the samples still in the window (amortised O(1)).
+Exponential forgetting multiplies all existing weights by λ (0 < λ ≤ 1) before each new sample, which only scales
+W, Sxx, Sxy, Syy and leaves the means unchanged. Without a window (size 0) old samples are never removed, so none are
+stored: the decayed moments alone carry the fit in O(1) memory.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <chrono>
+using namespace std;
+
+struct DataPoint {
+    double x, y, w;  // x, y coordinates and weight
+};
+
+class RollingWeightedLeastSquares {
+private:
+    // Ring buffer holding the samples currently in the window (empty when capacity is 0)
+    vector<DataPoint> window;
+    vector<long long> stamp;    // step at which each sample was added (for decayed weights)
+    int capacity;               // 0 = no window: forgetting only, samples are not stored
+    int head = 0;
+    long long count = 0;
+
+    double lambda;              // forgetting factor, 1 = no forgetting
+    int reanchorInterval;
+    int removalsSinceAnchor = 0;
+    long long step = 0;
+
+    double W = 0, meanX = 0, meanY = 0, Sxx = 0, Sxy = 0, Syy = 0;
+
+    double effectiveWeight(int slot) const {
+        if (lambda == 1.0) return window[slot].w;
+        return window[slot].w * pow(lambda, static_cast<double>(step - stamp[slot]));
+    }
+
+    void accumulate(double x, double y, double w) {
+        W += w;
+        double dx = x - meanX;
+        double dy = y - meanY;
+        meanX += (w / W) * dx;
+        meanY += (w / W) * dy;
+        Sxx += w * dx * (x - meanX);
+        Sxy += w * dx * (y - meanY);
+        Syy += w * dy * (y - meanY);
+    }
+
+    void downdate(double x, double y, double w) {
+        double W_new = W - w;
+        if (W_new <= 0) {
+            W = meanX = meanY = Sxx = Sxy = Syy = 0;
+            return;
+        }
+        double meanX_new = meanX - (w / W_new) * (x - meanX);
+        double meanY_new = meanY - (w / W_new) * (y - meanY);
+        Sxx -= w * (x - meanX_new) * (x - meanX);
+        Sxy -= w * (x - meanX_new) * (y - meanY);
+        Syy -= w * (y - meanY_new) * (y - meanY);
+        W = W_new;
+        meanX = meanX_new;
+        meanY = meanY_new;
+    }
+
+public:
+    RollingWeightedLeastSquares(int windowSize, double forgettingFactor = 1.0, int reanchorEvery = 0) {
+        capacity = windowSize;
+        lambda = forgettingFactor;
+        // Re-anchoring once per window length keeps the amortised cost O(1)
+        reanchorInterval = reanchorEvery > 0 ? reanchorEvery : max(windowSize, 1);
+        if (capacity > 0) {
+            window.resize(capacity);
+            stamp.resize(capacity);
+        }
+    }
+
+    // O(1): drops the oldest sample first if the window is full
+    void add(double x, double y, double w) {
+        if (capacity > 0 && count == capacity) {
+            remove();
+        }
+
+        step++;
+        if (lambda != 1.0) {
+            W *= lambda;
+            Sxx *= lambda;
+            Sxy *= lambda;
+            Syy *= lambda;
+        }
+
+        if (capacity > 0) {
+            int slot = (head + count) % capacity;
+            window[slot] = {x, y, w};
+            stamp[slot] = step;
+        }
+        count++;
+
+        accumulate(x, y, w);
+    }
+
+    // O(1): removes the oldest sample in the window
+    void remove() {
+        if (capacity == 0) {
+            cout << "No window: samples are only forgotten, not removed." << endl;
+            return;
+        }
+        if (count == 0) {
+            cout << "Window is empty. Nothing to remove." << endl;
+            return;
+        }
+
+        const DataPoint& p = window[head];
+        downdate(p.x, p.y, effectiveWeight(head));
+        head = (head + 1) % capacity;
+        count--;
+
+        if (++removalsSinceAnchor >= reanchorInterval) {
+            reanchor();
+        }
+    }
+
+    // Recompute the moments exactly from the samples in the window (two-pass, O(N)).
+    // Without a window there is no downdating drift to remove and no samples to recompute from.
+    void reanchor() {
+        if (capacity == 0) return;
+        W = meanX = meanY = Sxx = Sxy = Syy = 0;
+        for (int i = 0; i < count; i++) {
+            int slot = (head + i) % capacity;
+            accumulate(window[slot].x, window[slot].y, effectiveWeight(slot));
+        }
+        removalsSinceAnchor = 0;
+    }
+
+    long long size() const { return count; }
+
+    pair<double, double> fit() const {
+        if (count < 2 || Sxx <= 1e-12 * W) {
+            return {meanY, 0};
+        }
+        double b = Sxy / Sxx;
+        double a = meanY - b * meanX;
+        return {a, b};
+    }
+
+    double weightedSSE() const {
+        if (Sxx <= 0) return Syy;
+        return max(0.0, Syy - Sxy * Sxy / Sxx);
+    }
+};
+
+// Many independent windows of the same length updated together. Statistics are stored as structure-of-arrays
+// so updating all windows with one new sample each is a straight loop over contiguous arrays.
+class RollingRegressionBatch {
+private:
+    int numWindows, capacity;
+    int head = 0, count = 0;            // all windows advance in lockstep
+    vector<double> bufX, bufY, bufW;    // capacity x numWindows, one row per time slot
+    vector<double> W, meanX, meanY, Sxx, Sxy, Syy;
+    int removalsSinceAnchor = 0;
+
+public:
+    RollingRegressionBatch(int windows, int windowSize)
+        : numWindows(windows), capacity(windowSize),
+          bufX(static_cast<size_t>(windows) * windowSize), bufY(bufX.size()), bufW(bufX.size()),
+          W(windows, 0), meanX(windows, 0), meanY(windows, 0), Sxx(windows, 0), Sxy(windows, 0), Syy(windows, 0) {}
+
+    // x, y, w each hold one new sample per window
+    void addAll(const double* x, const double* y, const double* w) {
+        if (count == capacity) {
+            const double* ox = &bufX[static_cast<size_t>(head) * numWindows];
+            const double* oy = &bufY[static_cast<size_t>(head) * numWindows];
+            const double* ow = &bufW[static_cast<size_t>(head) * numWindows];
+            for (int k = 0; k < numWindows; k++) {
+                double W_new = W[k] - ow[k];
+                double inv = W_new > 0 ? ow[k] / W_new : 0.0;
+                double mx = meanX[k] - inv * (ox[k] - meanX[k]);
+                double my = meanY[k] - inv * (oy[k] - meanY[k]);
+                Sxx[k] -= ow[k] * (ox[k] - mx) * (ox[k] - meanX[k]);
+                Sxy[k] -= ow[k] * (ox[k] - mx) * (oy[k] - meanY[k]);
+                Syy[k] -= ow[k] * (oy[k] - my) * (oy[k] - meanY[k]);
+                W[k] = W_new;
+                meanX[k] = mx;
+                meanY[k] = my;
+            }
+            head = (head + 1) % capacity;
+            count--;
+            removalsSinceAnchor++;
+        }
+
+        int slot = (head + count) % capacity;
+        double* nx = &bufX[static_cast<size_t>(slot) * numWindows];
+        double* ny = &bufY[static_cast<size_t>(slot) * numWindows];
+        double* nw = &bufW[static_cast<size_t>(slot) * numWindows];
+        for (int k = 0; k < numWindows; k++) {
+            nx[k] = x[k];
+            ny[k] = y[k];
+            nw[k] = w[k];
+            double Wk = W[k] + w[k];
+            double r = w[k] / Wk;
+            double dx = x[k] - meanX[k];
+            double dy = y[k] - meanY[k];
+            meanX[k] += r * dx;
+            meanY[k] += r * dy;
+            Sxx[k] += w[k] * dx * (x[k] - meanX[k]);
+            Sxy[k] += w[k] * dx * (y[k] - meanY[k]);
+            Syy[k] += w[k] * dy * (y[k] - meanY[k]);
+            W[k] = Wk;
+        }
+        count++;
+
+        if (removalsSinceAnchor >= capacity) {
+            reanchor();
+        }
+    }
+
+    void reanchor() {
+        fill(W.begin(), W.end(), 0.0);
+        fill(meanX.begin(), meanX.end(), 0.0);
+        fill(meanY.begin(), meanY.end(), 0.0);
+        fill(Sxx.begin(), Sxx.end(), 0.0);
+        fill(Sxy.begin(), Sxy.end(), 0.0);
+        fill(Syy.begin(), Syy.end(), 0.0);
+        for (int i = 0; i < count; i++) {
+            size_t row = static_cast<size_t>((head + i) % capacity) * numWindows;
+            for (int k = 0; k < numWindows; k++) {
+                double xk = bufX[row + k], yk = bufY[row + k], wk = bufW[row + k];
+                W[k] += wk;
+                double dx = xk - meanX[k];
+                double dy = yk - meanY[k];
+                meanX[k] += (wk / W[k]) * dx;
+                meanY[k] += (wk / W[k]) * dy;
+                Sxx[k] += wk * dx * (xk - meanX[k]);
+                Sxy[k] += wk * dx * (yk - meanY[k]);
+                Syy[k] += wk * dy * (yk - meanY[k]);
+            }
+        }
+        removalsSinceAnchor = 0;
+    }
+
+    pair<double, double> fit(int k) const {
+        if (count < 2 || Sxx[k] <= 1e-12 * W[k]) {
+            return {meanY[k], 0};
+        }
+        double b = Sxy[k] / Sxx[k];
+        return {meanY[k] - b * meanX[k], b};
+    }
+};
+
+// Direct refit over the window from the normal equations, used as the reference
+pair<double, double> refitNormalEquations(const vector<DataPoint>& data, int first, int last) {
+    double sum_w = 0, sum_wx = 0, sum_wy = 0, sum_wx2 = 0, sum_wxy = 0;
+    for (int i = first; i < last; i++) {
+        const DataPoint& p = data[i];
+        sum_w += p.w;
+        sum_wx += p.w * p.x;
+        sum_wy += p.w * p.y;
+        sum_wx2 += p.w * p.x * p.x;
+        sum_wxy += p.w * p.x * p.y;
+    }
+    double det = sum_w * sum_wx2 - sum_wx * sum_wx;
+    if (abs(det) < 1e-12) {
+        return {0, 0};
+    }
+    double a = (sum_wy * sum_wx2 - sum_wx * sum_wxy) / det;
+    double b = (sum_w * sum_wxy - sum_wx * sum_wy) / det;
+    return {a, b};
+}
+
+int main() {
+    const int windowSize = 500;
+    const int numSamples = 200000;
+
+    // Stream y = 2 + 0.5x + noise, with a slope change halfway through
+    vector<DataPoint> stream(numSamples);
+    unsigned long long state = 12345;
+    auto noise = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5) * 0.2;
+    };
+    for (int i = 0; i < numSamples; i++) {
+        double x = 1000.0 + i * 0.01;                 // large offset stresses the raw-sum formulation
+        double slope = i < numSamples / 2 ? 0.5 : -1.5;
+        double w = 1.0 + (i % 4);                     // some measurements are more reliable
+        stream[i] = {x, 2.0 + slope * (x - 1000.0) + noise(), w};
+    }
+
+    cout << "=== ROLLING WEIGHTED LEAST SQUARES ===" << endl;
+    cout << "Window size N = " << windowSize << ", samples = " << numSamples << endl << endl;
+
+    RollingWeightedLeastSquares rolling(windowSize);
+
+    cout << setw(10) << "sample" << setw(16) << "rolling a" << setw(14) << "rolling b"
+         << setw(16) << "refit a" << setw(14) << "refit b" << endl;
+    cout << string(70, '-') << endl;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < numSamples; i++) {
+        rolling.add(stream[i].x, stream[i].y, stream[i].w);
+        if ((i + 1) % 40000 == 0) {
+            auto [a, b] = rolling.fit();
+            auto [ra, rb] = refitNormalEquations(stream, i + 1 - windowSize, i + 1);
+            cout << setw(10) << i + 1 << fixed << setprecision(6)
+                 << setw(16) << a << setw(14) << b << setw(16) << ra << setw(14) << rb << endl;
+        }
+    }
+    double rollingTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    double checksum = 0;
+    for (int i = windowSize; i <= numSamples; i++) {
+        checksum += refitNormalEquations(stream, i - windowSize, i).second;
+    }
+    double refitTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\nTime with O(1) add/remove: " << rollingTime << " s" << endl;
+    cout << "Time with O(N) refit per sample: " << refitTime << " s (checksum " << checksum << ")" << endl;
+
+    cout << "\n=== EXPONENTIAL FORGETTING ===" << endl;
+    RollingWeightedLeastSquares forgetting(0, 0.995);
+    for (int i = 0; i < numSamples; i++) {
+        forgetting.add(stream[i].x, stream[i].y, stream[i].w);
+    }
+    auto [fa, fb] = forgetting.fit();
+    cout << "λ = 0.995 (effective memory ≈ 200 samples): y = " << fa << " + " << fb << "x" << endl;
+
+    cout << "\n=== BATCHED WINDOWS ===" << endl;
+    const int numWindows = 1024;
+    RollingRegressionBatch batch(numWindows, 64);
+    vector<double> bx(numWindows), by(numWindows), bw(numWindows, 1.0);
+    for (int t = 0; t < 1000; t++) {
+        for (int k = 0; k < numWindows; k++) {
+            bx[k] = t;
+            by[k] = k * 0.001 * t + 1.0;   // window k sees slope k/1000
+        }
+        batch.addAll(bx.data(), by.data(), bw.data());
+    }
+    for (int k : {0, 1, 512, 1023}) {
+        auto [a, b] = batch.fit(k);
+        cout << "Window " << setw(4) << k << ": a = " << a << ", b = " << b
+             << " (expected b = " << k * 0.001 << ")" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,422 @@
+/*Whole-signal finite difference and Savitzky-Golay derivative kernels
+A finite difference stencil approximates the m-th derivative at xᵢ as a weighted sum of neighbouring samples:
+f⁽ᵐ⁾(xᵢ) ≈ (1/hᵐ) Σₖ wₖ · f(xᵢ + sₖh)
+The weights for any set of offsets sₖ come from Fornberg's recursion (exact for polynomials up to degree #offsets - 1).
+Central stencils are used in the interior; near the ends the offsets are shifted so they stay inside the array
+(one-sided stencils of the same accuracy).
+
+Savitzky-Golay filters fit a least-squares polynomial of degree p to a window of 2M+1 samples and differentiate
+the fitted polynomial, which smooths noise while differentiating:
+c = d! · eᵈᵀ (AᵀA)⁻¹ Aᵀ,  A[k][j] = sₖʲ
+Both kinds of filter reduce to "weights on offsets", so they share the same kernel.
+
+The kernel processes whole arrays. Stencils up to radius 4 are compiled per radius: groups of 8 outputs sum all
+taps in registers and are stored once, and the groups vectorize. Wider filters sweep the taps one at a time over
+L1-sized tiles. The array is cut into cache-sized blocks that worker threads claim one at a time.
+Compile with: g++ -std=c++17 -O3 -march=native -pthread
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+// Fornberg's algorithm: weights of the derivative of order m at 0 using samples at the given offsets
+vector<double> fornbergWeights(const vector<double>& offsets, int m) {
+    int n = offsets.size();
+    vector<vector<double>> c(n, vector<double>(m + 1, 0));
+    double c1 = 1, c4 = offsets[0];
+    c[0][0] = 1;
+    for (int i = 1; i < n; i++) {
+        int mn = min(i, m);
+        double c2 = 1;
+        double c5 = c4;
+        c4 = offsets[i];
+        for (int j = 0; j < i; j++) {
+            double c3 = offsets[i] - offsets[j];
+            c2 *= c3;
+            if (j == i - 1) {
+                for (int k = mn; k >= 1; k--) {
+                    c[i][k] = c1 * (k * c[i-1][k-1] - c5 * c[i-1][k]) / c2;
+                }
+                c[i][0] = -c1 * c5 * c[i-1][0] / c2;
+            }
+            for (int k = mn; k >= 1; k--) {
+                c[j][k] = (c4 * c[j][k] - k * c[j][k-1]) / c3;
+            }
+            c[j][0] = c4 * c[j][0] / c3;
+        }
+        c1 = c2;
+    }
+    vector<double> w(n);
+    for (int i = 0; i < n; i++) w[i] = c[i][m];
+    return w;
+}
+
+// Savitzky-Golay weights: derivative of order d of the degree-p least-squares fit over the offsets, evaluated at 0
+vector<double> savitzkyGolayWeights(const vector<double>& offsets, int p, int d) {
+    int n = offsets.size();
+    int cols = p + 1;
+
+    // Offsets are normalised to [-1, 1] so the normal equations stay well conditioned for wide windows
+    double spread = 0;
+    for (double s : offsets) spread = max(spread, abs(s));
+    vector<double> u(n);
+    for (int k = 0; k < n; k++) u[k] = offsets[k] / spread;
+
+    // Normal equations (AᵀA) z = e_d solved by Gauss elimination with partial pivoting
+    vector<vector<double>> M(cols, vector<double>(cols + 1, 0));
+    for (int r = 0; r < cols; r++) {
+        for (int c = 0; c < cols; c++) {
+            double sum = 0;
+            for (int k = 0; k < n; k++) sum += pow(u[k], r + c);
+            M[r][c] = sum;
+        }
+        M[r][cols] = (r == d) ? 1 : 0;
+    }
+    for (int k = 0; k < cols; k++) {
+        int maxRow = k;
+        for (int i = k + 1; i < cols; i++) {
+            if (abs(M[i][k]) > abs(M[maxRow][k])) maxRow = i;
+        }
+        swap(M[k], M[maxRow]);
+        for (int i = k + 1; i < cols; i++) {
+            double factor = M[i][k] / M[k][k];
+            for (int j = k; j <= cols; j++) M[i][j] -= factor * M[k][j];
+        }
+    }
+    vector<double> z(cols);
+    for (int i = cols - 1; i >= 0; i--) {
+        z[i] = M[i][cols];
+        for (int j = i + 1; j < cols; j++) z[i] -= M[i][j] * z[j];
+        z[i] /= M[i][i];
+    }
+
+    double dFactorial = 1;
+    for (int i = 2; i <= d; i++) dFactorial *= i;
+
+    vector<double> w(n);
+    for (int k = 0; k < n; k++) {
+        double sum = 0, power = 1;
+        for (int j = 0; j < cols; j++) {
+            sum += z[j] * power;
+            power *= u[k];
+        }
+        w[k] = dFactorial * sum / pow(spread, d);
+    }
+    return w;
+}
+
+// A derivative filter: interior weights on offsets -R..R plus one-sided weights for the R points at each end
+struct DerivativeFilter {
+    int radius;
+    vector<double> interior;                 // 2R+1 weights for offsets -R..R
+    int boundaryPoints;                      // points in each one-sided stencil
+    vector<vector<double>> left, right;      // left[i]: weights on y[0..], right[i]: weights on y[..n-1] for point n-1-i
+    double scale;                            // 1/hᵐ
+};
+
+DerivativeFilter makeStencilFilter(int derivative, int accuracy, double h) {
+    // A central stencil of accuracy order p for the m-th derivative needs 2⌊(m+1)/2⌋ - 1 + p points
+    int points = 2 * ((derivative + 1) / 2) - 1 + accuracy;
+    if (points % 2 == 0) points++;
+    int R = points / 2;
+
+    DerivativeFilter f;
+    f.radius = R;
+    f.scale = 1.0 / pow(h, derivative);
+
+    vector<double> offsets(points);
+    for (int k = 0; k < points; k++) offsets[k] = k - R;
+    f.interior = fornbergWeights(offsets, derivative);
+
+    // One-sided stencils are shifted to stay inside the array; they need m + p points (one more than the
+    // central stencil for even derivatives) to keep the same order of accuracy
+    int bp = max(points, derivative + accuracy);
+    f.boundaryPoints = bp;
+    offsets.resize(bp);
+    for (int i = 0; i < R; i++) {
+        for (int k = 0; k < bp; k++) offsets[k] = k - i;
+        f.left.push_back(fornbergWeights(offsets, derivative));
+        for (int k = 0; k < bp; k++) offsets[k] = i - (bp - 1) + k;
+        f.right.push_back(fornbergWeights(offsets, derivative));
+    }
+    return f;
+}
+
+DerivativeFilter makeSavitzkyGolayFilter(int halfWidth, int polyOrder, int derivative, double h) {
+    int points = 2 * halfWidth + 1;
+    DerivativeFilter f;
+    f.radius = halfWidth;
+    f.boundaryPoints = points;
+    f.scale = 1.0 / pow(h, derivative);
+
+    vector<double> offsets(points);
+    for (int k = 0; k < points; k++) offsets[k] = k - halfWidth;
+    f.interior = savitzkyGolayWeights(offsets, polyOrder, derivative);
+
+    for (int i = 0; i < halfWidth; i++) {
+        for (int k = 0; k < points; k++) offsets[k] = k - i;
+        f.left.push_back(savitzkyGolayWeights(offsets, polyOrder, derivative));
+        for (int k = 0; k < points; k++) offsets[k] = i - (points - 1) + k;
+        f.right.push_back(savitzkyGolayWeights(offsets, polyOrder, derivative));
+    }
+    return f;
+}
+
+// Interior points [begin, end) for a compile-time radius. Outputs are computed in groups of 8 whose sums stay in
+// registers: the tap loop is unrolled, each output is stored once, and the fixed-size group vectorizes even at -O2.
+// Without a centre tap (odd derivatives of central stencils) the zero weight is not multiplied at all.
+template <int R, bool Centre>
+void applyInteriorFixed(const double* w, const double* __restrict y, double* __restrict out,
+                        size_t begin, size_t end) {
+    const int group = 8;
+    double taps[2 * R + 1];
+    for (int k = 0; k < 2 * R + 1; k++) taps[k] = w[k];
+    size_t i = begin;
+    for (; i + group <= end; i += group) {
+        double sum[group] = {};
+#pragma GCC unroll 9
+        for (int k = 0; k < 2 * R + 1; k++) {
+            if (k == R && !Centre) continue;
+#pragma GCC unroll 8
+            for (int j = 0; j < group; j++) sum[j] += taps[k] * y[i + j + k - R];
+        }
+#pragma GCC unroll 8
+        for (int j = 0; j < group; j++) out[i + j] = sum[j];
+    }
+    for (; i < end; i++) {
+        double sum = 0;
+        for (int k = 0; k < 2 * R + 1; k++) {
+            if (k == R && !Centre) continue;
+            sum += taps[k] * y[i + k - R];
+        }
+        out[i] = sum;
+    }
+}
+
+// Wide filters (Savitzky-Golay windows): one contiguous multiply-add sweep per tap over tiles small enough that the
+// output tile stays in L1 while the taps are accumulated into it. The first tap initializes the tile.
+void applyInteriorWide(int R, const double* w, const double* __restrict y, double* __restrict out,
+                       size_t begin, size_t end) {
+    const size_t tile = 512;
+    for (size_t t0 = begin; t0 < end; t0 += tile) {
+        size_t t1 = min(end, t0 + tile), count = t1 - t0;
+        const double* window = y + (t0 - R);   // t0 ≥ R: never points before y
+        double* tileOut = out + t0;
+        for (size_t i = 0; i < count; i++) tileOut[i] = w[0] * window[i];
+        for (int k = 1; k < 2 * R + 1; k++) {
+            if (w[k] == 0) continue;
+            double wk = w[k];
+            const double* shifted = window + k;
+            for (size_t i = 0; i < count; i++) tileOut[i] += wk * shifted[i];
+        }
+    }
+}
+
+// Interior points [begin, end) with the scaled weights w (2R+1 of them); begin ≥ R and end ≤ n - R
+void applyInterior(int R, const double* w, const double* y, double* out, size_t begin, size_t end) {
+    bool centre = w[R] != 0;
+    switch (R) {
+        case 1: return centre ? applyInteriorFixed<1, true>(w, y, out, begin, end)
+                              : applyInteriorFixed<1, false>(w, y, out, begin, end);
+        case 2: return centre ? applyInteriorFixed<2, true>(w, y, out, begin, end)
+                              : applyInteriorFixed<2, false>(w, y, out, begin, end);
+        case 3: return centre ? applyInteriorFixed<3, true>(w, y, out, begin, end)
+                              : applyInteriorFixed<3, false>(w, y, out, begin, end);
+        case 4: return centre ? applyInteriorFixed<4, true>(w, y, out, begin, end)
+                              : applyInteriorFixed<4, false>(w, y, out, begin, end);
+        default: return applyInteriorWide(R, w, y, out, begin, end);
+    }
+}
+
+void applyBoundaries(const DerivativeFilter& f, const double* y, double* out, size_t n) {
+    int R = f.radius;
+    int points = f.boundaryPoints;
+    for (int i = 0; i < R; i++) {
+        double sum = 0;
+        for (int k = 0; k < points; k++) sum += f.left[i][k] * y[k];
+        out[i] = sum * f.scale;
+
+        size_t j = n - 1 - i;
+        sum = 0;
+        for (int k = 0; k < points; k++) sum += f.right[i][k] * y[n - points + k];
+        out[j] = sum * f.scale;
+    }
+}
+
+// Differentiates a whole signal. Blocks of blockSize samples (sized so input and output stay in L2) are handed
+// out to threads through an atomic counter, which balances load without a fixed partition.
+void differentiate(const DerivativeFilter& f, const vector<double>& y, vector<double>& out,
+                   int numThreads = 0, size_t blockSize = 16384) {
+    size_t n = y.size();
+    size_t R = f.radius;
+    if (n < 2 * R + 1 || n < static_cast<size_t>(f.boundaryPoints)) {
+        cout << "Signal is shorter than the stencil. Cannot differentiate." << endl;
+        out.clear();
+        return;
+    }
+    out.resize(n);
+
+    applyBoundaries(f, y.data(), out.data(), n);
+    vector<double> w(f.interior);
+    for (double& wk : w) wk *= f.scale;
+
+    size_t first = R, last = n - R;
+    size_t numBlocks = (last - first + blockSize - 1) / blockSize;
+    if (numThreads <= 0) numThreads = max(1u, thread::hardware_concurrency());
+    numThreads = min<size_t>(numThreads, numBlocks);
+
+    atomic<size_t> nextBlock(0);
+    auto worker = [&]() {
+        for (size_t b = nextBlock++; b < numBlocks; b = nextBlock++) {
+            size_t begin = first + b * blockSize;
+            size_t end = min(last, begin + blockSize);
+            applyInterior(f.radius, w.data(), y.data(), out.data(), begin, end);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < numThreads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+int main() {
+    cout << "=== WHOLE-SIGNAL FINITE DIFFERENCE KERNELS ===" << endl;
+
+    // Accuracy on a coarse grid, where truncation error dominates rounding error
+    const size_t coarseN = 10001;
+    const double coarseH = 100.0 / (coarseN - 1);
+    vector<double> coarse(coarseN), out;
+    for (size_t i = 0; i < coarseN; i++) coarse[i] = sin(i * coarseH);
+
+    cout << "Signal: f(x) = sin(x) on [0, 100], n = " << coarseN << ", h = " << coarseH << endl << endl;
+
+    cout << "Central stencil weights for f'(x), accuracy O(h⁴):" << endl;
+    DerivativeFilter d4 = makeStencilFilter(1, 4, coarseH);
+    for (double w : d4.interior) cout << "  " << fixed << setprecision(6) << w;
+    cout << endl << endl;
+
+    cout << setw(12) << "derivative" << setw(10) << "accuracy" << setw(8) << "points"
+         << setw(16) << "max error" << endl;
+    cout << string(46, '-') << endl;
+
+    for (int m = 1; m <= 2; m++) {
+        for (int p : {2, 4, 6}) {
+            DerivativeFilter f = makeStencilFilter(m, p, coarseH);
+            differentiate(f, coarse, out);
+
+            // The maximum includes the one-sided boundary stencils
+            double maxError = 0;
+            for (size_t i = 0; i < coarseN; i++) {
+                double exact = (m == 1) ? cos(i * coarseH) : -sin(i * coarseH);
+                maxError = max(maxError, abs(out[i] - exact));
+            }
+            cout << setw(12) << m << setw(10) << p << setw(8) << 2 * f.radius + 1
+                 << setw(16) << scientific << setprecision(3) << maxError << endl;
+        }
+    }
+
+    // Throughput: the kernel against one bounds-checked call per point (centralDifference(index) for 3 points, the
+    // same loop over the stencil weights for wider stencils). Best of 3 runs, 1 thread unless stated.
+    auto bestOf3 = [](auto&& run) {
+        double best = 1e300;
+        for (int r = 0; r < 3; r++) {
+            auto start = chrono::steady_clock::now();
+            run();
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+    auto pointByPoint = [](const DerivativeFilter& f, const vector<double>& s, vector<double>& o, double h) {
+        size_t len = s.size();
+        size_t R = f.radius;
+        auto centralDifference = [&](size_t index) {
+            if (index <= 0 || index >= len - 1) {
+                return 0.0;
+            }
+            return (s[index+1] - s[index-1]) / (2*h);
+        };
+        auto stencilAt = [&](size_t index) {
+            if (index < R || index + R >= len) {
+                return 0.0;
+            }
+            double sum = 0;
+            for (size_t k = 0; k < 2 * R + 1; k++) sum += f.interior[k] * s[index + k - R];
+            return sum * f.scale;
+        };
+        if (R == 1) for (size_t i = 0; i < len; i++) o[i] = centralDifference(i);
+        else for (size_t i = 0; i < len; i++) o[i] = stencilAt(i);
+    };
+
+    cout << "\n=== THROUGHPUT (first derivative, million points per second) ===" << endl;
+    cout << setw(10) << "points" << setw(12) << "n" << setw(16) << "point-by-point" << setw(14) << "kernel"
+         << setw(10) << "speedup" << endl;
+    cout << string(62, '-') << endl;
+    for (size_t n : {size_t(16384), size_t(20000000)}) {
+        // Small signals are repeated so that every row processes 2·10⁸ points
+        const size_t repeats = max<size_t>(1, 200000000 / n / 10);
+        const double h = 100.0 / (n - 1);
+        vector<double> y(n);
+        for (size_t i = 0; i < n; i++) y[i] = sin(i * h);
+        out.assign(n, 0);
+        for (int p : {2, 4, 6}) {
+            DerivativeFilter f = makeStencilFilter(1, p, h);
+            double tPoint = bestOf3([&]() {
+                for (size_t r = 0; r < repeats; r++) pointByPoint(f, y, out, h);
+            });
+            double tKernel = bestOf3([&]() {
+                for (size_t r = 0; r < repeats; r++) differentiate(f, y, out, 1);
+            });
+            double points = static_cast<double>(n) * repeats / 1e6;
+            cout << setw(10) << 2 * f.radius + 1 << setw(12) << n << setw(16) << fixed << setprecision(0)
+                 << points / tPoint << setw(14) << points / tKernel << setw(9) << setprecision(2)
+                 << tPoint / tKernel << "x" << endl;
+        }
+        if (n > 16384 && thread::hardware_concurrency() > 1) {
+            DerivativeFilter f = makeStencilFilter(1, 2, h);
+            double tParallel = bestOf3([&]() { differentiate(f, y, out); });
+            cout << "3-point kernel on " << thread::hardware_concurrency() << " threads: " << setprecision(0)
+                 << n / tParallel / 1e6 << " million points per second" << endl;
+        }
+    }
+    cout << "At n = 16384 the signal stays in cache and the vectorized kernel wins by its arithmetic. At 2·10⁷ both"
+         << endl << "loops stream from memory, and a single thread is limited by bandwidth rather than by the stencil."
+         << endl;
+
+    cout << "\n=== SAVITZKY-GOLAY SMOOTHING DERIVATIVE ===" << endl;
+    const size_t noisyN = 100001;
+    const double noisyH = 10.0 / (noisyN - 1);
+    vector<double> noisy(noisyN);
+    unsigned long long state = 2024;
+    for (size_t i = 0; i < noisyN; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        noisy[i] = sin(i * noisyH) + 1e-6 * (static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5);
+    }
+    cout << "f(x) = sin(x) + uniform noise of amplitude 1e-6, h = " << scientific << noisyH << endl;
+
+    auto interiorError = [&](size_t margin) {
+        double e = 0;
+        for (size_t i = margin; i < noisyN - margin; i++) e = max(e, abs(out[i] - cos(i * noisyH)));
+        return e;
+    };
+
+    DerivativeFilter raw = makeStencilFilter(1, 2, noisyH);
+    differentiate(raw, noisy, out);
+    double rawError = interiorError(50);
+
+    DerivativeFilter sg = makeSavitzkyGolayFilter(50, 3, 1, noisyH);
+    differentiate(sg, noisy, out);
+    double sgError = interiorError(50);
+
+    cout << "3-point central difference, interior max error:      " << rawError << endl;
+    cout << "Savitzky-Golay (101 points, cubic), interior max error: " << sgError << endl;
+
+    return 0;
+}
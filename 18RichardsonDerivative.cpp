@@ -0,0 +1,236 @@
+/*Richardson Extrapolation for Derivatives (Ridders' tableau)
+A difference quotient D(h) has an error expansion in powers of h:
+Central:  D(h) = (f(x+h) - f(x-h)) / 2h      = f'(x) + a₂h² + a₄h⁴ + ...
+Forward:  D(h) = (f(x+h) - f(x)) / h          = f'(x) + a₁h + a₂h² + ...
+Second:   D(h) = (f(x+h) - 2f(x) + f(x-h)) / h² = f''(x) + a₂h² + a₄h⁴ + ...
+
+Evaluating D at h, h/2, h/4, ... and combining neighbours eliminates the leading error terms one by one:
+T[i][0] = D(h/2ⁱ)
+T[i][j] = T[i][j-1] + (T[i][j-1] - T[i-1][j-1]) / (2^(p·j) - 1)     p = 2 for central, 1 for forward
+
+Shrinking h reduces truncation error but increases rounding error (~ ε|f|/hᵐ). Each new tableau entry comes with
+an error estimate (its distance from the two entries it was built from); the entry with the smallest estimate is
+returned, and the tableau stops once the error grows clearly past the best one, i.e. rounding has taken over.
+Because the steps are exact powers of two, points such as f(x) are shared between levels and evaluated only once.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <limits>
+using namespace std;
+
+struct DerivativeResult {
+    double value;       // best extrapolated derivative
+    double error;       // estimated absolute error
+    double step;        // step size of the row the best value came from
+    int evaluations;    // distinct function evaluations used
+};
+
+enum class DifferenceScheme { Central, Forward, SecondCentral };
+
+class RichardsonDerivative {
+private:
+    int maxLevels;
+    double growthStop;  // stop once the error estimate exceeds growthStop × best error
+
+    // Function values at x + offset; offsets are exact binary fractions of h₀, so equality lookup is safe
+    struct EvaluationCache {
+        vector<pair<double, double>> entries;
+        int evaluations = 0;
+
+        double get(const function<double(double)>& f, double x, double offset) {
+            for (const auto& e : entries) {
+                if (e.first == offset) return e.second;
+            }
+            double value = f(x + offset);
+            entries.push_back({offset, value});
+            evaluations++;
+            return value;
+        }
+    };
+
+public:
+    RichardsonDerivative(int levels = 12, double stopFactor = 2.0) {
+        maxLevels = levels;
+        growthStop = stopFactor;
+    }
+
+    // Starting step: large enough that the first rows are truncation-dominated, scaled to the magnitude of x
+    static double initialStep(double x) {
+        return 0.25 * max(1.0, abs(x));
+    }
+
+    DerivativeResult derivative(const function<double(double)>& f, double x,
+                                DifferenceScheme scheme = DifferenceScheme::Central, double h0 = 0) const {
+        if (h0 <= 0) h0 = initialStep(x);
+        // Round h₀ to a power of two so every step h₀/2ⁱ is exact and shared points are found exactly
+        h0 = ldexp(1.0, static_cast<int>(floor(log2(h0))));
+
+        int p = (scheme == DifferenceScheme::Forward) ? 1 : 2;
+        EvaluationCache cache;
+
+        auto quotient = [&](double h) {
+            switch (scheme) {
+                case DifferenceScheme::Central:
+                    return (cache.get(f, x, h) - cache.get(f, x, -h)) / (2 * h);
+                case DifferenceScheme::Forward:
+                    return (cache.get(f, x, h) - cache.get(f, x, 0)) / h;
+                default:
+                    return (cache.get(f, x, h) - 2 * cache.get(f, x, 0) + cache.get(f, x, -h)) / (h * h);
+            }
+        };
+
+        // Only two rows of the tableau are alive at any time
+        vector<double> previous(maxLevels), current(maxLevels);
+        DerivativeResult best = {0, numeric_limits<double>::infinity(), h0, 0};
+
+        double h = h0;
+        previous[0] = quotient(h);
+        best.value = previous[0];
+
+        for (int i = 1; i < maxLevels; i++) {
+            h *= 0.5;
+            current[0] = quotient(h);
+            double factor = 1;
+            for (int j = 1; j <= i; j++) {
+                factor *= (p == 2) ? 4 : 2;
+                current[j] = current[j-1] + (current[j-1] - previous[j-1]) / (factor - 1);
+                double err = max(abs(current[j] - current[j-1]), abs(current[j] - previous[j-1]));
+                if (err <= best.error) {
+                    best.value = current[j];
+                    best.error = err;
+                    best.step = h;
+                }
+            }
+            // Rounding error now dominates the higher-order entries: further rows will only get worse
+            if (abs(current[i] - previous[i-1]) >= growthStop * best.error) break;
+            swap(previous, current);
+        }
+
+        best.evaluations = cache.evaluations;
+        return best;
+    }
+
+    // ∂f/∂xₖ for every coordinate; coordinates are claimed by threads through an atomic counter
+    vector<DerivativeResult> gradient(const function<double(const vector<double>&)>& f, const vector<double>& x,
+                                      int numThreads = 0) const {
+        int n = x.size();
+        vector<DerivativeResult> result(n);
+        if (numThreads <= 0) numThreads = max(1u, thread::hardware_concurrency());
+        numThreads = min(numThreads, max(1, n));
+
+        atomic<int> next(0);
+        auto worker = [&]() {
+            vector<double> point = x;  // private copy per thread, only coordinate k is perturbed
+            for (int k = next++; k < n; k = next++) {
+                auto partial = [&](double xk) {
+                    point[k] = xk;
+                    double value = f(point);
+                    point[k] = x[k];
+                    return value;
+                };
+                result[k] = derivative(partial, x[k]);
+            }
+        };
+
+        vector<thread> pool;
+        for (int t = 1; t < numThreads; t++) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+        return result;
+    }
+};
+
+// Rosenbrock function in n dimensions
+double rosenbrock(const vector<double>& x) {
+    double sum = 0;
+    for (size_t i = 0; i + 1 < x.size(); i++) {
+        double a = x[i+1] - x[i]*x[i];
+        double b = 1 - x[i];
+        sum += 100*a*a + b*b;
+    }
+    return sum;
+}
+
+vector<double> rosenbrockGradient(const vector<double>& x) {
+    size_t n = x.size();
+    vector<double> g(n, 0);
+    for (size_t i = 0; i + 1 < n; i++) {
+        double a = x[i+1] - x[i]*x[i];
+        g[i] += -400*x[i]*a - 2*(1 - x[i]);
+        g[i+1] += 200*a;
+    }
+    return g;
+}
+
+int main() {
+    RichardsonDerivative engine;
+
+    cout << "=== RICHARDSON-EXTRAPOLATED DERIVATIVES ===" << endl;
+    cout << "f(x) = eˣ sin(x) at x = 1, exact f'(1) = e(sin 1 + cos 1)" << endl << endl;
+
+    auto f = [](double x) { return exp(x) * sin(x); };
+    double exact = exp(1.0) * (sin(1.0) + cos(1.0));
+
+    cout << setw(28) << "method" << setw(16) << "value" << setw(14) << "true error"
+         << setw(14) << "est. error" << setw(8) << "evals" << endl;
+    cout << string(80, '-') << endl;
+
+    cout << scientific << setprecision(4);
+    for (double h : {1e-1, 1e-3, 1e-5, 1e-8}) {
+        double central = (f(1 + h) - f(1 - h)) / (2 * h);
+        cout << setw(22) << "fixed central, h = " << setw(6) << setprecision(0) << h
+             << setw(16) << fixed << setprecision(10) << central
+             << setw(14) << scientific << setprecision(3) << abs(central - exact)
+             << setw(14) << "-" << setw(8) << 2 << endl;
+    }
+
+    DerivativeResult r = engine.derivative(f, 1.0);
+    cout << setw(28) << "Richardson (central)" << setw(16) << fixed << setprecision(10) << r.value
+         << setw(14) << scientific << setprecision(3) << abs(r.value - exact)
+         << setw(14) << r.error << setw(8) << r.evaluations << endl;
+
+    r = engine.derivative(f, 1.0, DifferenceScheme::Forward);
+    cout << setw(28) << "Richardson (forward)" << setw(16) << fixed << setprecision(10) << r.value
+         << setw(14) << scientific << setprecision(3) << abs(r.value - exact)
+         << setw(14) << r.error << setw(8) << r.evaluations << endl;
+
+    double exact2 = 2 * exp(1.0) * cos(1.0);
+    r = engine.derivative(f, 1.0, DifferenceScheme::SecondCentral);
+    cout << setw(28) << "Richardson f''" << setw(16) << fixed << setprecision(10) << r.value
+         << setw(14) << scientific << setprecision(3) << abs(r.value - exact2)
+         << setw(14) << r.error << setw(8) << r.evaluations << endl;
+
+    cout << "\n=== PARALLEL GRADIENT ===" << endl;
+    const int dims = 400;
+    vector<double> x(dims);
+    for (int i = 0; i < dims; i++) x[i] = 0.5 + 0.001 * i;
+    vector<double> g = rosenbrockGradient(x);
+
+    for (int threads : {1, 0}) {
+        auto start = chrono::steady_clock::now();
+        vector<DerivativeResult> grad = engine.gradient(rosenbrock, x, threads);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        double maxError = 0, maxEstimate = 0;
+        long long evaluations = 0;
+        for (int i = 0; i < dims; i++) {
+            maxError = max(maxError, abs(grad[i].value - g[i]));
+            maxEstimate = max(maxEstimate, grad[i].error);
+            evaluations += grad[i].evaluations;
+        }
+        int used = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+        cout << "Rosenbrock, n = " << dims << ", threads = " << used
+             << ": max error = " << maxError << ", max estimate = " << maxEstimate
+             << ", evaluations = " << evaluations << ", time = " << fixed << setprecision(4) << elapsed
+             << " s" << scientific << setprecision(3) << endl;
+    }
+
+    return 0;
+}
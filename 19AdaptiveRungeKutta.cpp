@@ -0,0 +1,248 @@
+/*Adaptive Step-Size Runge-Kutta (embedded pairs)
+An embedded pair computes two solutions of different order from the same stages:
+yₙ₊₁ = yₙ + h Σ bᵢkᵢ        (order p, the one that is kept)
+ŷₙ₊₁ = yₙ + h Σ b̂ᵢkᵢ        (order p-1, only used for the error estimate)
+errₙ = |yₙ₊₁ - ŷₙ₊₁| / (atol + rtol·max(|yₙ|, |yₙ₊₁|))
+
+A step is accepted when errₙ ≤ 1. The next step size follows a PI controller (Gustafsson), which damps the
+oscillation of the classic h·err^(-1/q) rule:
+hₙ₊₁ = hₙ · safety · errₙ^(-α) · errₙ₋₁^(β),   α = 0.7/q, β = 0.4/q,  q = p (order of the error estimate + 1)
+
+Dormand-Prince 5(4): 7 stages, 6 evaluations per step thanks to FSAL (First Same As Last: the last stage is
+f(xₙ₊₁, yₙ₊₁), which is the first stage of the next step).
+Bogacki-Shampine 3(2): 4 stages, 3 evaluations per step with FSAL; cheaper for loose tolerances.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+using namespace std;
+
+struct EmbeddedTableau {
+    string name;
+    int stages;
+    int order;                    // order of the propagated solution
+    vector<double> c;
+    vector<vector<double>> a;     // a[i][j], j < i
+    vector<double> b, bhat;
+    bool fsal;
+};
+
+EmbeddedTableau dormandPrince54() {
+    return {"Dormand-Prince 5(4)", 7, 5,
+        {0, 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1, 1},
+        {{},
+         {1.0/5},
+         {3.0/40, 9.0/40},
+         {44.0/45, -56.0/15, 32.0/9},
+         {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+         {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+         {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84}},
+        {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84, 0},
+        {5179.0/57600, 0, 7571.0/16695, 393.0/640, -92097.0/339200, 187.0/2100, 1.0/40},
+        true};
+}
+
+EmbeddedTableau bogackiShampine32() {
+    return {"Bogacki-Shampine 3(2)", 4, 3,
+        {0, 1.0/2, 3.0/4, 1},
+        {{},
+         {1.0/2},
+         {0, 3.0/4},
+         {2.0/9, 1.0/3, 4.0/9}},
+        {2.0/9, 1.0/3, 4.0/9, 0},
+        {7.0/24, 1.0/4, 1.0/3, 1.0/8},
+        true};
+}
+
+struct IntegrationStats {
+    long long accepted = 0;
+    long long rejected = 0;
+    long long evaluations = 0;
+};
+
+class AdaptiveRungeKutta {
+private:
+    EmbeddedTableau tab;
+    double atol, rtol;
+    double safety = 0.9, facMin = 0.2, facMax = 5.0;
+    IntegrationStats stats;
+
+public:
+    AdaptiveRungeKutta(const EmbeddedTableau& tableau, double absTol, double relTol) {
+        tab = tableau;
+        atol = absTol;
+        rtol = relTol;
+    }
+
+    const IntegrationStats& statistics() const { return stats; }
+
+    // Starting step from the size of y and y' (Hairer, Nørsett & Wanner, Section II.4)
+    double initialStep(const function<double(double, double)>& f, double x0, double y0, double f0) {
+        double sc = atol + rtol * abs(y0);
+        double d0 = abs(y0) / sc, d1 = abs(f0) / sc;
+        double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+        double f1 = f(x0 + h0, y0 + h0 * f0);
+        stats.evaluations++;
+        double d2 = abs(f1 - f0) / sc / h0;
+        double h1 = max(d1, d2) <= 1e-15 ? max(1e-6, h0 * 1e-3) : pow(0.01 / max(d1, d2), 1.0 / tab.order);
+        return min(100 * h0, h1);
+    }
+
+    // Integrates y' = f(x, y) from x0 to x_final; onStep(x, y) is called after every accepted step
+    double solve(const function<double(double, double)>& f, double x0, double y0, double x_final,
+                 const function<void(double, double)>& onStep = nullptr) {
+        stats = IntegrationStats();
+        int s = tab.stages;
+        vector<double> k(s);
+        double q = tab.order;
+        double alpha = 0.7 / q, beta = 0.4 / q;
+
+        double x = x0, y = y0;
+        k[0] = f(x, y);
+        stats.evaluations++;
+        double h = initialStep(f, x0, y0, k[0]);
+        double errPrev = 1.0;
+        bool rejectedLast = false;
+
+        while (x < x_final) {
+            if (x + h > x_final) h = x_final - x;
+
+            for (int i = 1; i < s; i++) {
+                double yi = y;
+                for (int j = 0; j < i; j++) yi += h * tab.a[i][j] * k[j];
+                k[i] = f(x + tab.c[i] * h, yi);
+            }
+            stats.evaluations += s - 1;
+
+            double yNew = y, errEstimate = 0;
+            for (int i = 0; i < s; i++) {
+                yNew += h * tab.b[i] * k[i];
+                errEstimate += h * (tab.b[i] - tab.bhat[i]) * k[i];
+            }
+            double err = abs(errEstimate) / (atol + rtol * max(abs(y), abs(yNew)));
+
+            if (err <= 1.0) {
+                x += h;
+                y = yNew;
+                stats.accepted++;
+                if (tab.fsal) {
+                    k[0] = k[s - 1];
+                } else {
+                    k[0] = f(x, y);
+                    stats.evaluations++;
+                }
+                if (onStep) onStep(x, y);
+
+                double factor = safety * pow(max(err, 1e-10), -alpha) * pow(errPrev, beta);
+                factor = min(rejectedLast ? 1.0 : facMax, max(facMin, factor));
+                h *= factor;
+                errPrev = max(err, 1e-4);
+                rejectedLast = false;
+            } else {
+                stats.rejected++;
+                h *= max(facMin, safety * pow(err, -alpha));
+                rejectedLast = true;
+            }
+
+            if (h < 1e-14 * max(1.0, abs(x))) {
+                cout << "Step size underflow at x = " << x << ". Integration stopped." << endl;
+                return y;
+            }
+        }
+        return y;
+    }
+};
+
+// Fixed-step classical RK4, the step of DenseRungeKutta4 (13.cpp), for comparison; returns the max error along the path
+double fixedStepRK4Error(const function<double(double, double)>& f, const function<double(double)>& exact,
+                         double x0, double y0, double x_final, int steps) {
+    double h = (x_final - x0) / steps;
+    double x = x0, y = y0, maxError = 0;
+    for (int i = 0; i < steps; i++) {
+        double k1 = h * f(x, y);
+        double k2 = h * f(x + h/2, y + k1/2);
+        double k3 = h * f(x + h/2, y + k2/2);
+        double k4 = h * f(x + h, y + k3);
+        y += (k1 + 2*k2 + 2*k3 + k4) / 6;
+        x = x0 + (i + 1) * h;
+        maxError = max(maxError, abs(y - exact(x)));
+    }
+    return maxError;
+}
+
+// Smallest number of RK4 steps (to within a factor 1.19) whose max error along the path reaches the target
+int rk4StepsForError(const function<double(double, double)>& f, const function<double(double)>& exact,
+                     double x0, double y0, double x_final, double target) {
+    double steps = 4;
+    while (steps < 1e8) {
+        int n = static_cast<int>(steps);
+        if (fixedStepRK4Error(f, exact, x0, y0, x_final, n) <= target) return n;
+        steps *= 1.19;
+    }
+    return static_cast<int>(steps);
+}
+
+// W(e^L), solving w + ln w = L by Newton's method (works for L far beyond the range of exp)
+double lambertWOfExp(double L) {
+    double w = L > 1 ? L - log(L) : exp(L);
+    for (int i = 0; i < 50; i++) {
+        double step = (w + log(w) - L) / (1 + 1 / w);
+        w -= step;
+        if (abs(step) < 1e-15 * w) break;
+    }
+    return w;
+}
+
+void compare(const string& title, const function<double(double, double)>& f, const function<double(double)>& exact,
+             double x0, double x_final) {
+    cout << "\n=== " << title << " ===" << endl;
+    cout << setw(24) << "method" << setw(8) << "tol" << setw(12) << "max error" << setw(10) << "steps"
+         << setw(10) << "rejected" << setw(10) << "f evals" << setw(14) << "RK4 f evals" << setw(10) << "ratio"
+         << endl;
+    cout << string(98, '-') << endl;
+
+    for (const EmbeddedTableau& tab : {bogackiShampine32(), dormandPrince54()}) {
+        for (double tol : {1e-4, 1e-7, 1e-10}) {
+            AdaptiveRungeKutta solver(tab, tol, tol);
+            double maxError = 0;
+            solver.solve(f, x0, exact(x0), x_final, [&](double x, double y) {
+                maxError = max(maxError, abs(y - exact(x)));
+            });
+            const IntegrationStats& st = solver.statistics();
+
+            int rk4Steps = rk4StepsForError(f, exact, x0, exact(x0), x_final, max(maxError, 1e-14));
+            long long rk4Evals = 4LL * rk4Steps;
+
+            cout << setw(24) << tab.name << setw(8) << scientific << setprecision(0) << tol
+                 << setw(12) << setprecision(2) << maxError << setw(10) << st.accepted << setw(10) << st.rejected
+                 << setw(10) << st.evaluations << setw(14) << rk4Evals
+                 << setw(10) << fixed << setprecision(1) << static_cast<double>(rk4Evals) / st.evaluations << endl;
+        }
+    }
+}
+
+int main() {
+    cout << "=== ADAPTIVE EMBEDDED RUNGE-KUTTA ===" << endl;
+    cout << "Error control: atol = rtol = tol, PI step-size controller, FSAL stage reuse" << endl;
+    cout << "RK4 f evals: fixed-step RK4 evaluations needed for the same max error along the solution" << endl;
+
+    // 11.cpp: dy/dx = x² + y, y(0) = 1, exact y = -x² - 2x - 2 + 3eˣ
+    compare("dy/dx = x² + y on [0, 2]", [](double x, double y) { return x*x + y; },
+            [](double x) { return -x*x - 2*x - 2 + 3*exp(x); }, 0.0, 2.0);
+
+    // Flame propagation (y' = y² - y³, y(0) = δ): a long slow phase, a sudden ignition, then a flat tail.
+    // Exact solution y = 1/(W(a·e^(a-t)) + 1), a = 1/δ - 1, with W the Lambert W function.
+    double delta = 1e-3;
+    double a = 1 / delta - 1;
+    compare("Flame: y' = y² - y³, y(0) = 1e-3 on [0, 1050]", [](double, double y) { return y*y - y*y*y; },
+            [a](double t) { return 1 / (lambertWOfExp(log(a) + a - t) + 1); }, 0.0, 1 / delta + 50);
+
+    cout << "\nThe adaptive solvers take large steps where the solution is smooth and" << endl;
+    cout << "small steps only around the ignition, while fixed-step RK4 must use the small step everywhere." << endl;
+
+    return 0;
+}
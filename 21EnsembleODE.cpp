@@ -0,0 +1,471 @@
+/*Ensemble ODE Integration
+Uncertainty quantification runs the same ODE y' = F(t, y; p) from many initial conditions y₀ and parameter sets p.
+Calling a scalar solver once per member runs them one at a time on one core.
+
+The ensemble integrator instead:
+1. Stores members as structure-of-arrays: every per-member quantity (t, h, each component of y and of every stage)
+   is a GCC/Clang vector of B doubles, and lane l of all of them belongs to the same member. A Runge-Kutta stage,
+   the error estimate and the step size controller are then plain vector arithmetic, whatever the optimization
+   level; a comparison gives a per-lane mask and ?: on masks selects per lane, with no branch. B should be the
+   number of doubles in a vector register (2 with SSE2, 4 with AVX, 8 with AVX-512), which the example picks from
+   the target, so the gain over one member at a time grows with the register width.
+2. Advances B members (lanes) together with Dormand-Prince 5(4). Every member keeps its own t, h and error
+   control; a rejected step simply keeps that lane's state. The controller's log and exp are short inline
+   polynomials on the bit patterns, because libm would be called lane by lane. Adaptive members finish at very
+   different times, so a lane whose member is done is immediately refilled with the next member instead of
+   waiting for its neighbours.
+3. Deals chunks of members out to threads with work stealing: each thread owns a deque of chunks and takes work
+   from the back; when it runs dry it steals from the front of another thread's deque.
+4. Writes every member's final state and step count straight into preallocated output arrays. A member whose step
+   size underflows (h < 1e-14·max(1, |t|), as in 19AdaptiveRungeKutta.cpp) is retired early and flagged as failed.
+
+Example: damped oscillators x'' + 2ζωx' + ω²x = 0 with random ω and ζ.
+*/
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+class WorkStealingQueues {
+private:
+    vector<deque<int>> queues;
+    vector<mutex> locks;
+
+public:
+    WorkStealingQueues(int workers, int items) : queues(workers), locks(workers) {
+        // Contiguous ranges per worker keep neighbouring chunks on the same thread
+        for (int i = 0; i < items; i++) {
+            queues[static_cast<long long>(i) * workers / items].push_back(i);
+        }
+    }
+
+    bool next(int worker, int& item) {
+        {
+            lock_guard<mutex> guard(locks[worker]);
+            if (!queues[worker].empty()) {
+                item = queues[worker].back();
+                queues[worker].pop_back();
+                return true;
+            }
+        }
+        int n = queues.size();
+        for (int offset = 1; offset < n; offset++) {
+            int victim = (worker + offset) % n;
+            lock_guard<mutex> guard(locks[victim]);
+            if (!queues[victim].empty()) {
+                item = queues[victim].front();
+                queues[victim].pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// B lanes: Lanes holds one double per lane, LaneBits the same bits as int64_t, and LaneMask is what comparing two
+// Lanes gives. For B > 1 they are GCC/Clang vectors and a true mask lane is all ones; for B = 1 they are plain
+// double, int64_t and bool, so one member at a time runs as ordinary scalar code.
+// Spelled out per width: GCC drops vector_size from some uses of a typedef whose size depends on a template argument.
+template <int B> struct LaneTypes;
+template <> struct LaneTypes<1> {
+    typedef double Lanes;
+    typedef int64_t LaneBits;
+    typedef bool LaneMask;
+};
+template <> struct LaneTypes<2> {
+    typedef double Lanes __attribute__((vector_size(16)));
+    typedef int64_t LaneBits __attribute__((vector_size(16)));
+    typedef LaneBits LaneMask;
+};
+template <> struct LaneTypes<4> {
+    typedef double Lanes __attribute__((vector_size(32)));
+    typedef int64_t LaneBits __attribute__((vector_size(32)));
+    typedef LaneBits LaneMask;
+};
+template <> struct LaneTypes<8> {
+    typedef double Lanes __attribute__((vector_size(64)));
+    typedef int64_t LaneBits __attribute__((vector_size(64)));
+    typedef LaneBits LaneMask;
+};
+
+// Doubles per vector register of the target. With B = registerLanes every Lanes operation is one instruction;
+// a wider B still works, but the compiler emulates the vector piece by piece and it runs slower than scalar code.
+#if defined(__AVX512F__)
+const int registerLanes = 8;
+#elif defined(__AVX__)
+const int registerLanes = 4;
+#else
+const int registerLanes = 2;
+#endif
+
+// Element l of a vector, or the value itself when B = 1
+template <class V>
+inline auto lane(V& v, int l) -> decltype((v[l])) { return v[l]; }
+inline double& lane(double& x, int) { return x; }
+inline int64_t& lane(int64_t& x, int) { return x; }
+inline bool& lane(bool& x, int) { return x; }
+
+template <class To, class From>
+inline To bitCast(const From& from) {
+    static_assert(sizeof(To) == sizeof(From), "bitCast needs equal sizes");
+    To to;
+    memcpy(&to, &from, sizeof(To));
+    return to;
+}
+
+// log₂ x for positive normal x in every lane, accurate to about 3e-6: plenty for a step size controller, whose
+// factors are clamped to [0.2, 5] anyway. Short polynomials evaluated in parallel halves (Estrin) keep the latency
+// low, and with few lanes the controller sits on the critical path of every step.
+template <class Real, class Bits>
+void log2Positive(const Real& x, Real& result) {
+    const Real magic = Real{} + 0x1.8p52;
+    Bits bits = bitCast<Bits>(x);
+    // Exponent to double through the 1.5·2⁵² trick; AVX2 has no 64-bit integer to double conversion
+    Real e = bitCast<Real>(bitCast<Bits>(magic) + (bits >> 52)) - magic - 1023;
+    Real m = bitCast<Real>((bits & 0x000FFFFFFFFFFFFFll) | 0x3FF0000000000000ll);
+    auto high = m > M_SQRT2;
+    m = high ? 0.5 * m : m;
+    e = high ? e + 1 : e;
+    // ln m = 2 atanh s = 2s(1 + z/3 + z²/5 + ...), s = (m - 1)/(m + 1), |s| < 0.172, z = s²
+    Real s = (m - 1) / (m + 1), z = s * s;
+    Real series = (2 * M_LOG2E) * s * ((1 + z * (1.0 / 3)) + (z * z) * (1.0 / 5));
+    result = e + series;
+}
+
+// 2ˣ for |x| < 1000 in every lane, accurate to about 3e-6
+template <class Real, class Bits>
+void exp2Moderate(const Real& x, Real& result) {
+    const Real magic = Real{} + 0x1.8p52;
+    Real t = x + magic;
+    Real n = t - magic;
+    Bits ni = bitCast<Bits>(t) - bitCast<Bits>(magic);
+    // e^r = 1 + r + r²/2 + ... + r⁵/120 for r = (x - n)·ln 2, |r| ≤ ln2/2
+    Real r = (x - n) * M_LN2, r2 = r * r;
+    Real p = ((1 + r) + r2 * (1.0 / 2 + r * (1.0 / 6))) + (r2 * r2) * (1.0 / 24 + r * (1.0 / 120));
+    result = p * bitCast<Real>((ni + 1023) << 52);
+}
+
+// Dim: state dimension, NumParams: parameters per member, B: members advanced together (SIMD lanes)
+template <int Dim, int NumParams, int B>
+class EnsembleIntegrator {
+public:
+    typedef typename LaneTypes<B>::Lanes Lanes;
+    typedef typename LaneTypes<B>::LaneBits LaneBits;
+    typedef typename LaneTypes<B>::LaneMask LaneMask;
+
+private:
+    double atol, rtol;
+
+    // Lane-local working set, one per thread
+    struct Workspace {
+        Lanes t, h, log2ErrPrev, tStage;
+        Lanes y[Dim], stage[Dim], yNew[Dim], k[7][Dim], kFresh[Dim];
+        Lanes p[NumParams > 0 ? NumParams : 1];
+        LaneMask rejectedLast, failed;
+        LaneBits steps;
+        int member[B];          // member in each lane, -1 when the lane is idle
+    };
+
+    // Supplies member indices chunk by chunk, stealing chunks from other threads when its own run out
+    struct MemberSource {
+        WorkStealingQueues& queues;
+        int worker, chunkSize, members;
+        int next = 0, end = 0;
+
+        bool take(int& m) {
+            if (next == end) {
+                int chunk;
+                if (!queues.next(worker, chunk)) return false;
+                next = chunk * chunkSize;
+                end = min(members, next + chunkSize);
+            }
+            m = next++;
+            return true;
+        }
+    };
+
+    // Advances B lanes with Dormand-Prince 5(4). When a member reaches t1 its result is written out and the
+    // lane is refilled with the next member, so lanes never idle while waiting for a slow neighbour.
+    template <class Rhs>
+    void integrateLanes(Rhs& rhs, Workspace& w, MemberSource& source, int members,
+                        const double* y0, const double* params, double t0, double t1,
+                        double* yOut, long long* stepsOut, unsigned char* failedOut) const {
+        static const double a[7][6] = {
+            {},
+            {1.0/5},
+            {3.0/40, 9.0/40},
+            {44.0/45, -56.0/15, 32.0/9},
+            {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+            {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+            {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84}};
+        static const double c[7] = {0, 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1, 1};
+        static const double e[7] = {35.0/384 - 5179.0/57600, 0, 500.0/1113 - 7571.0/16695,
+                                    125.0/192 - 393.0/640, -2187.0/6784 + 92097.0/339200,
+                                    11.0/84 - 187.0/2100, -1.0/40};
+        const double alpha = 0.7 / 5, beta = 0.4 / 5;
+        const double log2Floor = log2(1e-4);
+
+        // Writes finished lanes out and loads new members; returns false once every lane is idle
+        auto refill = [&](bool initial) {
+            bool loaded = false, anyBusy = false;
+            for (int l = 0; l < B; l++) {
+                if (!initial && w.member[l] >= 0 && lane(w.t, l) < t1 && !lane(w.failed, l)) {
+                    anyBusy = true;
+                    continue;
+                }
+                if (!initial && w.member[l] >= 0) {
+                    for (int d = 0; d < Dim; d++) yOut[static_cast<size_t>(d) * members + w.member[l]] = lane(w.y[d], l);
+                    stepsOut[w.member[l]] = lane(w.steps, l);
+                    failedOut[w.member[l]] = lane(w.failed, l) != 0;
+                }
+                int m;
+                if (source.take(m)) {
+                    w.member[l] = m;
+                    for (int d = 0; d < Dim; d++) lane(w.y[d], l) = y0[static_cast<size_t>(d) * members + m];
+                    for (int q = 0; q < NumParams; q++) lane(w.p[q], l) = params[static_cast<size_t>(q) * members + m];
+                    lane(w.t, l) = t0;
+                    lane(w.h, l) = 1e-3 * (t1 - t0);
+                    lane(w.log2ErrPrev, l) = 0.0;
+                    lane(w.rejectedLast, l) = 0;
+                    lane(w.failed, l) = 0;
+                    lane(w.steps, l) = 0;
+                    loaded = anyBusy = true;
+                } else {
+                    // Idle lane: parked at t1 with h = 0, its arithmetic is harmless
+                    w.member[l] = -1;
+                    lane(w.t, l) = t1;
+                    lane(w.h, l) = 0;
+                    lane(w.failed, l) = 0;
+                }
+            }
+            if (loaded) {
+                // One evaluation over all lanes gives the first stage of every newly loaded member
+                rhs(w.t, w.y, w.kFresh, w.p);
+                for (int d = 0; d < Dim; d++) {
+                    for (int l = 0; l < B; l++) {
+                        if (w.member[l] >= 0 && lane(w.steps, l) == 0 && lane(w.t, l) == t0) lane(w.k[0][d], l) = lane(w.kFresh[d], l);
+                    }
+                }
+            }
+            return anyBusy;
+        };
+
+        for (int l = 0; l < B; l++) w.member[l] = -1;
+        refill(true);
+
+        while (true) {
+            Lanes remaining = t1 - w.t;
+            w.h = w.h < remaining ? w.h : remaining;
+
+            for (int i = 1; i < 7; i++) {
+                Lanes* target = (i == 6) ? w.yNew : w.stage;
+                for (int d = 0; d < Dim; d++) {
+                    Lanes sum = {};
+                    for (int j = 0; j < i; j++) sum += a[i][j] * w.k[j][d];
+                    target[d] = w.y[d] + w.h * sum;
+                }
+                w.tStage = w.t + c[i] * w.h;
+                rhs(w.tStage, target, w.k[i], w.p);
+            }
+
+            Lanes err = {};
+            for (int d = 0; d < Dim; d++) {
+                Lanes sum = {};
+                for (int j = 0; j < 7; j++) sum += e[j] * w.k[j][d];
+                Lanes yMagnitude = w.y[d] < 0 ? -w.y[d] : w.y[d];
+                Lanes yNewMagnitude = w.yNew[d] < 0 ? -w.yNew[d] : w.yNew[d];
+                Lanes sc = atol + rtol * (yMagnitude > yNewMagnitude ? yMagnitude : yNewMagnitude);
+                Lanes r = w.h * sum / sc;
+                r = r < 0 ? -r : r;
+                err = (r > err) | (r != r) ? r : err;  // a NaN (overflowed state) must reject the step
+            }
+
+            // Per-lane accept/reject as mask selects
+            LaneMask moving = w.h > 0;
+            LaneMask accept = (err <= 1.0) & moving;
+            // PI controller in log form: one log and two exp per lane instead of three pow calls.
+            // The error is clamped to [1e-10, 1e10] first, with NaN going to 1e10 (the largest shrink).
+            Lanes errClamped = err < 1e10 ? (err > 1e-10 ? err : 1e-10) : 1e10;
+            Lanes log2Err, grow, shrink;
+            log2Positive<Lanes, LaneBits>(errClamped, log2Err);
+            exp2Moderate<Lanes, LaneBits>(-alpha * log2Err + beta * w.log2ErrPrev, grow);
+            exp2Moderate<Lanes, LaneBits>(-alpha * log2Err, shrink);
+            grow *= 0.9;
+            grow = grow > 0.2 ? grow : 0.2;
+            Lanes growLimit = w.rejectedLast ? 1.0 : 5.0;
+            grow = grow < growLimit ? grow : growLimit;
+            shrink *= 0.9;
+            shrink = shrink > 0.2 ? shrink : 0.2;
+
+            for (int d = 0; d < Dim; d++) {
+                w.y[d] = accept ? w.yNew[d] : w.y[d];
+                w.k[0][d] = accept ? w.k[6][d] : w.k[0][d];  // FSAL
+            }
+            w.t = accept ? w.t + w.h : w.t;
+            w.steps += accept & 1;
+            w.log2ErrPrev = accept ? (log2Err > log2Floor ? log2Err : log2Floor) : w.log2ErrPrev;
+            w.rejectedLast = moving & ((err > 1.0) | (err != err));
+            w.h *= accept ? grow : shrink;
+            // Step size underflow retires the lane: its member is written out as failed at the next refill
+            Lanes tMagnitude = w.t < 0 ? -w.t : w.t;
+            tMagnitude = tMagnitude > 1.0 ? tMagnitude : 1.0;
+            w.failed = (w.t < t1) & (w.h < 1e-14 * tMagnitude);
+
+            LaneMask finished = (accept & (w.t >= t1)) | w.failed;
+            bool anyFinished = false;
+            for (int l = 0; l < B; l++) anyFinished |= lane(finished, l) != 0;
+            if (anyFinished && !refill(false)) break;
+        }
+    }
+
+public:
+    EnsembleIntegrator(double absTol, double relTol) : atol(absTol), rtol(relTol) {}
+
+    // y0, params and yOut are structure-of-arrays: component d of member m is at [d * members + m].
+    // rhs(const Lanes& t, const Lanes* y, Lanes* dy, const Lanes* p), with Dim entries in y and dy and NumParams in
+    // p, evaluates all lanes at once.
+    // failedOut[m] is set for members stopped by step size underflow; yOut then holds the state where they stopped.
+    template <class Rhs>
+    void integrate(Rhs rhs, int members, const double* y0, const double* params, double t0, double t1,
+                   double* yOut, long long* stepsOut, unsigned char* failedOut, int numThreads = 0) const {
+        const int chunkSize = 16 * B;
+        int chunks = (members + chunkSize - 1) / chunkSize;
+        if (numThreads <= 0) numThreads = max(1u, thread::hardware_concurrency());
+        numThreads = max(1, min(numThreads, chunks));
+
+        WorkStealingQueues queues(numThreads, chunks);
+        auto worker = [&](int id) {
+            auto w = make_unique<Workspace>();
+            MemberSource source{queues, id, chunkSize, members};
+            integrateLanes(rhs, *w, source, members, y0, params, t0, t1, yOut, stepsOut, failedOut);
+        };
+
+        vector<thread> pool;
+        for (int id = 1; id < numThreads; id++) pool.emplace_back(worker, id);
+        worker(0);
+        for (auto& th : pool) th.join();
+    }
+};
+
+// x'' + 2ζωx' + ω²x = 0 as y = (x, v), parameters p = (ω, ζ)
+struct DampedOscillator {
+    template <class Lanes>
+    void operator()(const Lanes& /*t*/, const Lanes* y, Lanes* dy, const Lanes* p) const {
+        const Lanes& omega = p[0];
+        const Lanes& zeta = p[1];
+        dy[0] = y[1];
+        dy[1] = -2 * zeta * omega * y[1] - omega * omega * y[0];
+    }
+};
+
+// Exact x(t) for x(0) = x0, x'(0) = v0, underdamped (ζ < 1)
+double oscillatorExact(double omega, double zeta, double x0, double v0, double t) {
+    double wd = omega * sqrt(1 - zeta * zeta);
+    double A = x0, Bc = (v0 + zeta * omega * x0) / wd;
+    return exp(-zeta * omega * t) * (A * cos(wd * t) + Bc * sin(wd * t));
+}
+
+int main() {
+    const int members = 50000;
+    const double t1 = 10.0;
+
+    vector<double> y0(2 * members), params(2 * members), yOut(2 * members);
+    vector<long long> steps(members);
+    vector<unsigned char> failed(members);
+    unsigned long long state = 99;
+    auto uniform = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    for (int m = 0; m < members; m++) {
+        y0[m] = 1.0 + 0.1 * (uniform() - 0.5);        // x(0)
+        y0[members + m] = 0.0;                        // v(0)
+        params[m] = 1.0 + 29.0 * uniform() * uniform();  // ω: most members slow, a few fast
+        params[members + m] = 0.05 + 0.4 * uniform();    // ζ
+    }
+
+    cout << fixed << setprecision(3);
+    cout << "=== ENSEMBLE ODE INTEGRATION ===" << endl;
+    cout << "Damped oscillators x'' + 2ζωx' + ω²x = 0, " << members << " members, t ∈ [0, " << t1 << "]" << endl;
+    cout << "ω ∈ [1, 30], ζ ∈ [0.05, 0.45], Dormand-Prince 5(4), tol = 1e-8" << endl << endl;
+
+    double oneAtATimeTime = 0;
+    auto report = [&](const string& label, double elapsed) {
+        double maxError = 0;
+        long long totalSteps = 0, minSteps = steps[0], maxSteps = steps[0];
+        int failures = 0;
+        for (int m = 0; m < members; m++) {
+            failures += failed[m];
+            double exact = oscillatorExact(params[m], params[members + m], y0[m], y0[members + m], t1);
+            maxError = max(maxError, abs(yOut[m] - exact));
+            totalSteps += steps[m];
+            minSteps = min(minSteps, steps[m]);
+            maxSteps = max(maxSteps, steps[m]);
+        }
+        cout << setw(34) << left << label << right << setw(10) << elapsed << " s"
+             << "   max error " << scientific << setprecision(2) << maxError << fixed << setprecision(3)
+             << "   steps/member " << minSteps << ".." << maxSteps << " (total " << totalSteps << ")"
+             << "   failed " << failures;
+        if (oneAtATimeTime > 0) cout << "   " << setprecision(2) << oneAtATimeTime / elapsed << "× faster" << setprecision(3);
+        cout << endl;
+    };
+
+    {
+        EnsembleIntegrator<2, 2, 1> oneAtATime(1e-8, 1e-8);
+        auto start = chrono::steady_clock::now();
+        oneAtATime.integrate(DampedOscillator(), members, y0.data(), params.data(), 0.0, t1,
+                             yOut.data(), steps.data(), failed.data(), 1);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        report("one member at a time, 1 thread", elapsed);
+        oneAtATimeTime = elapsed;
+    }
+    {
+        EnsembleIntegrator<2, 2, registerLanes> lanes(1e-8, 1e-8);
+        auto start = chrono::steady_clock::now();
+        lanes.integrate(DampedOscillator(), members, y0.data(), params.data(), 0.0, t1,
+                        yOut.data(), steps.data(), failed.data(), 1);
+        report("SoA, " + to_string(registerLanes) + " lanes, 1 thread", chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    {
+        EnsembleIntegrator<2, 2, registerLanes> lanes(1e-8, 1e-8);
+        auto start = chrono::steady_clock::now();
+        lanes.integrate(DampedOscillator(), members, y0.data(), params.data(), 0.0, t1,
+                        yOut.data(), steps.data(), failed.data());
+        report("SoA, " + to_string(registerLanes) + " lanes, " + to_string(max(1u, thread::hardware_concurrency())) + " thread(s)",
+               chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+
+    // ζ = -40 makes x grow like e^(1200t): once it overflows the error estimate is NaN, every step is rejected
+    // and h shrinks towards zero. Those lanes are retired as failed while their neighbours finish normally.
+    {
+        const int few = 8;
+        vector<double> y0s(2 * few), ps(2 * few), out(2 * few);
+        vector<long long> st(few);
+        vector<unsigned char> fl(few);
+        for (int m = 0; m < few; m++) {
+            y0s[m] = 1.0;
+            y0s[few + m] = 0.0;
+            ps[m] = 15.0;
+            ps[few + m] = m % 2 ? -40.0 : 0.2;
+        }
+        EnsembleIntegrator<2, 2, registerLanes> lanes(1e-8, 1e-8);
+        lanes.integrate(DampedOscillator(), few, y0s.data(), ps.data(), 0.0, t1, out.data(), st.data(), fl.data(), 1);
+        cout << "\nUnstable members (odd members, ζ = -40):" << endl;
+        for (int m = 0; m < few; m++) {
+            cout << "  member " << m << ": " << (fl[m] ? "failed (step size underflow)" : "ok") << ", "
+                 << st[m] << " steps, x = " << scientific << setprecision(3) << out[m] << fixed << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,559 @@
+/*Asynchronous Binary Trajectory Output
+RungeKutta2nd::solve (11.cpp) prints every step with setw/setprecision and endl. Formatting a double as text costs
+far more than an RK2 step, and endl flushes the stream each time, so with per-step output the integration runs at
+the speed of the terminal or disk.
+
+Here the solver thread only copies the values of a step into a preallocated chunk (columnar: all x, then all y, ...).
+Full chunks travel to a background writer thread through a lock-free single-producer/single-consumer ring, and
+empty chunks come back through a second ring, so nothing is allocated or locked in the integration loop.
+The writer thread encodes and writes the chunks:
+
+File format (little-endian):
+  header:  "TRJ1", uint32 columns, uint32 flags (bit 0: compressed), uint32 decimation, uint32 chunkRecords
+  blocks:  uint32 records (at most chunkRecords), then per column uint32 byteLength + payload
+Payload: raw doubles, or compressed:
+  1. XOR each value with the previous one in its column: smooth data shares sign, exponent and leading mantissa bits,
+     so the XOR has many leading zero bytes.
+  2. Byte-plane transpose: all most-significant bytes first, so the zero bytes form long runs.
+  3. Run-length encoding of zero bytes: a token byte t; t ≥ 128 means (t - 127) zero bytes, otherwise (t + 1)
+     literal bytes follow.
+The reader memory-maps the file and decodes columns without copying the file through stream buffers. Every length
+read from the file is checked against the mapping and the header before it is used, so a truncated or damaged file
+is reported instead of being read out of bounds.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// Lock-free ring for one producer thread and one consumer thread
+template <class T>
+class SpscRing {
+private:
+    vector<T> slots;
+    size_t mask;
+    alignas(64) atomic<size_t> head{0};   // next slot to read, owned by the consumer
+    alignas(64) atomic<size_t> tail{0};   // next slot to write, owned by the producer
+
+    // The index mask needs a power-of-two size, so any other capacity is rounded up
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    explicit SpscRing(size_t capacity) : slots(roundUpPowerOfTwo(capacity)), mask(slots.size() - 1) {}
+
+    bool tryPush(const T& value) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == slots.size()) return false;
+        slots[t & mask] = value;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) return false;
+        value = slots[h & mask];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+struct TrajectoryChunk {
+    int records = 0;
+    vector<double> values;  // column-major: values[column * capacity + record]
+};
+
+enum class OverflowPolicy { Block, Drop };
+
+struct WriterOptions {
+    int decimation = 1;             // keep every decimation-th record
+    bool compress = true;
+    int chunkRecords = 8192;
+    int ringChunks = 16;            // chunks in flight between the solver and the writer thread
+    OverflowPolicy overflow = OverflowPolicy::Block;
+};
+
+struct WriterStats {
+    long long recorded = 0, dropped = 0, stalls = 0;
+    long long rawBytes = 0, writtenBytes = 0;
+};
+
+// XOR delta, byte-plane transpose and zero-run RLE (see the file header comment)
+void compressColumn(const double* values, int count, vector<uint8_t>& planes, vector<uint8_t>& out) {
+    planes.resize(static_cast<size_t>(count) * 8);
+    uint64_t previous = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t bits;
+        memcpy(&bits, &values[i], 8);
+        uint64_t x = bits ^ previous;
+        previous = bits;
+        for (int b = 0; b < 8; b++) planes[static_cast<size_t>(7 - b) * count + i] = static_cast<uint8_t>(x >> (8 * b));
+    }
+
+    out.clear();
+    size_t n = planes.size(), i = 0;
+    while (i < n) {
+        if (planes[i] == 0) {
+            size_t run = 1;
+            while (i + run < n && planes[i + run] == 0 && run < 128) run++;
+            out.push_back(static_cast<uint8_t>(127 + run));
+            i += run;
+        } else {
+            size_t run = 1;
+            // A literal run ends at the first pair of zeros (a single zero is cheaper inside the literal)
+            while (i + run < n && run < 128 && !(planes[i + run] == 0 && i + run + 1 < n && planes[i + run + 1] == 0)) run++;
+            out.push_back(static_cast<uint8_t>(run - 1));
+            out.insert(out.end(), planes.begin() + i, planes.begin() + i + run);
+            i += run;
+        }
+    }
+}
+
+// Returns false when the runs do not decode to exactly count·8 bytes within length bytes of input
+bool decompressColumn(const uint8_t* data, size_t length, int count, vector<uint8_t>& planes, double* values) {
+    planes.resize(static_cast<size_t>(count) * 8);
+    size_t pos = 0, written = 0;
+    while (pos < length) {
+        uint8_t token = data[pos++];
+        if (token >= 128) {
+            size_t run = token - 127;
+            if (written + run > planes.size()) return false;
+            memset(&planes[written], 0, run);
+            written += run;
+        } else {
+            size_t run = token + 1;
+            if (run > length - pos || written + run > planes.size()) return false;
+            memcpy(&planes[written], &data[pos], run);
+            pos += run;
+            written += run;
+        }
+    }
+    if (written != planes.size()) return false;
+
+    uint64_t previous = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t x = 0;
+        for (int b = 0; b < 8; b++) x |= static_cast<uint64_t>(planes[static_cast<size_t>(7 - b) * count + i]) << (8 * b);
+        previous ^= x;
+        memcpy(&values[i], &previous, 8);
+    }
+    return true;
+}
+
+class TrajectoryWriter {
+private:
+    int columns;
+    WriterOptions options;
+    string path;
+    FILE* file;
+    vector<TrajectoryChunk> chunks;
+    SpscRing<TrajectoryChunk*> filled, recycled;
+    TrajectoryChunk* current = nullptr;
+    atomic<bool> closing{false};
+    thread worker;
+    int decimationCounter = 0;
+    WriterStats stats;
+    atomic<long long> rawBytes{0}, writtenBytes{0};
+    atomic<bool> writeFailed{false};
+
+    // After the first short write (disk full, I/O error) the rest of the file is useless, so later chunks are only recycled
+    void writeChunk(const TrajectoryChunk& chunk, vector<uint8_t>& planes, vector<uint8_t>& encoded) {
+        if (writeFailed.load(memory_order_relaxed)) return;
+        uint32_t records = chunk.records;
+        bool ok = fwrite(&records, 4, 1, file) == 1;
+        long long bytes = 4;
+        for (int c = 0; c < columns && ok; c++) {
+            const double* column = &chunk.values[static_cast<size_t>(c) * options.chunkRecords];
+            const void* payload = column;
+            uint32_t length = chunk.records * 8;
+            if (options.compress) {
+                compressColumn(column, chunk.records, planes, encoded);
+                length = encoded.size();
+                payload = encoded.data();
+            }
+            ok = fwrite(&length, 4, 1, file) == 1 && fwrite(payload, 1, length, file) == length;
+            bytes += 4 + length;
+        }
+        if (!ok) {
+            writeFailed.store(true, memory_order_relaxed);
+            return;
+        }
+        rawBytes += 8LL * chunk.records * columns;
+        writtenBytes += bytes;
+    }
+
+    void writerLoop() {
+        vector<uint8_t> planes, encoded;
+        TrajectoryChunk* chunk;
+        while (true) {
+            if (filled.tryPop(chunk)) {
+                writeChunk(*chunk, planes, encoded);
+                chunk->records = 0;
+                recycled.tryPush(chunk);  // cannot fail: there are only ringChunks chunks in total
+            } else if (closing.load(memory_order_acquire)) {
+                if (!filled.tryPop(chunk)) break;
+                writeChunk(*chunk, planes, encoded);
+            } else {
+                this_thread::sleep_for(chrono::microseconds(100));
+            }
+        }
+    }
+
+    void publish() {
+        if (current->records == 0) return;
+        filled.tryPush(current);  // always has room: every chunk in flight came out of 'recycled'
+        current = nullptr;
+        while (!recycled.tryPop(current)) {
+            if (options.overflow == OverflowPolicy::Drop) {
+                current = &spare;
+                spare.records = 0;
+                return;
+            }
+            stats.stalls++;
+            this_thread::yield();
+        }
+    }
+
+    // Drop policy: when the writer falls behind, records go to this chunk and are discarded
+    TrajectoryChunk spare;
+
+public:
+    TrajectoryWriter(const string& path, int numColumns, const WriterOptions& opts = WriterOptions())
+        : columns(numColumns), options(opts), path(path), filled(max(opts.ringChunks, 1)), recycled(max(opts.ringChunks, 1)) {
+        options.decimation = max(options.decimation, 1);
+        options.chunkRecords = max(options.chunkRecords, 1);
+        options.ringChunks = max(options.ringChunks, 1);
+        file = fopen(path.c_str(), "wb");
+        if (!file) {
+            cout << "Cannot open " << path << " for writing." << endl;
+            return;
+        }
+        setvbuf(file, nullptr, _IOFBF, 1 << 20);
+        uint32_t header[5] = {0, static_cast<uint32_t>(columns), options.compress ? 1u : 0u,
+                              static_cast<uint32_t>(options.decimation), static_cast<uint32_t>(options.chunkRecords)};
+        memcpy(header, "TRJ1", 4);
+        if (fwrite(header, 4, 5, file) != 5) writeFailed = true;
+
+        chunks.resize(options.ringChunks);
+        for (auto& c : chunks) {
+            c.values.resize(static_cast<size_t>(columns) * options.chunkRecords);
+            recycled.tryPush(&c);
+        }
+        spare.values.resize(static_cast<size_t>(columns) * options.chunkRecords);
+        recycled.tryPop(current);
+        worker = thread(&TrajectoryWriter::writerLoop, this);
+    }
+
+    ~TrajectoryWriter() { close(); }
+
+    bool isOpen() const { return file != nullptr; }
+
+    // Called from the integration loop: a decimation check and a copy into the current chunk.
+    // A writer that failed to open or is already closed has no chunk and ignores the record.
+    void record(const double* values) {
+        if (!current) return;
+        if (++decimationCounter < options.decimation) return;
+        decimationCounter = 0;
+        TrajectoryChunk* chunk = current;
+        int r = chunk->records;
+        for (int c = 0; c < columns; c++) chunk->values[static_cast<size_t>(c) * options.chunkRecords + r] = values[c];
+        chunk->records = r + 1;
+        if (chunk == &spare) stats.dropped++;
+        else stats.recorded++;
+        if (chunk->records == options.chunkRecords) {
+            if (chunk == &spare) {
+                spare.records = 0;
+                if (recycled.tryPop(current)) return;
+                current = &spare;
+            } else {
+                publish();
+            }
+        }
+    }
+
+    // Returns false (and says so) if any part of the file could not be written
+    bool close() {
+        if (!file) return false;
+        if (current != &spare) publish();
+        current = nullptr;
+        closing.store(true, memory_order_release);
+        worker.join();
+        if (fclose(file) != 0) writeFailed = true;
+        file = nullptr;
+        stats.rawBytes = rawBytes;
+        stats.writtenBytes = writtenBytes;
+        if (writeFailed) cout << "Write to " << path << " failed; the file is incomplete." << endl;
+        return !writeFailed;
+    }
+
+    const WriterStats& statistics() const { return stats; }
+};
+
+// Memory-mapped reader for the format above
+class TrajectoryReader {
+private:
+    string path;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    int columns = 0, decimation = 1;
+    uint32_t chunkRecords = 0;
+    bool compressed = false;
+
+    static constexpr size_t headerBytes = 20;
+
+    uint32_t read32(size_t pos) const {
+        uint32_t v;
+        memcpy(&v, data + pos, 4);
+        return v;
+    }
+
+public:
+    explicit TrajectoryReader(const string& filePath) : path(filePath) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            cout << "Cannot open " << path << "." << endl;
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            cout << "Cannot open " << path << "." << endl;
+            ::close(fd);
+            return;
+        }
+        size = st.st_size;
+        void* mapped = size >= headerBytes ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (mapped == MAP_FAILED || memcmp(mapped, "TRJ1", 4) != 0) {
+            cout << path << " is not a trajectory file." << endl;
+            if (mapped != MAP_FAILED) munmap(mapped, size);
+            return;
+        }
+        data = static_cast<const uint8_t*>(mapped);
+        uint32_t numColumns = read32(4), factor = read32(12);
+        chunkRecords = read32(16);
+        if (numColumns == 0 || numColumns > (size - headerBytes) / 4 + 1 || factor == 0 || chunkRecords == 0
+            || chunkRecords > INT32_MAX / 8) {
+            cout << path << " is not a trajectory file." << endl;
+            munmap(mapped, size);
+            data = nullptr;
+            return;
+        }
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        columns = numColumns;
+        compressed = read32(8) & 1;
+        decimation = factor;
+    }
+
+    ~TrajectoryReader() {
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+    }
+
+    bool isOpen() const { return data != nullptr; }
+    int numColumns() const { return columns; }
+    int decimationFactor() const { return decimation; }
+
+    // Decodes all columns: result[c][record]; empty when the file is truncated or damaged
+    vector<vector<double>> readAll() const {
+        vector<vector<double>> result(columns);
+        vector<uint8_t> planes;
+        size_t pos = headerBytes;
+        while (pos < size) {
+            uint32_t records = size - pos >= 4 ? read32(pos) : 0;
+            if (records == 0 || records > chunkRecords) {
+                cout << path << " has a damaged block at byte " << pos << "." << endl;
+                return {};
+            }
+            pos += 4;
+            for (int c = 0; c < columns; c++) {
+                uint32_t length = size - pos >= 4 ? read32(pos) : 0;
+                pos += 4;
+                bool fits = pos <= size && length <= size - pos && (compressed || length == records * 8);
+                size_t start = result[c].size();
+                if (fits) {
+                    result[c].resize(start + records);
+                    if (compressed) fits = decompressColumn(data + pos, length, records, planes, &result[c][start]);
+                    else memcpy(&result[c][start], data + pos, length);
+                }
+                if (!fits) {
+                    cout << path << " has a damaged column " << c << " at byte " << pos - 4 << "." << endl;
+                    return {};
+                }
+                pos += length;
+            }
+        }
+        return result;
+    }
+};
+
+// 11.cpp: dy/dx = x² + y, y(0) = 1
+double f(double x, double y) {
+    return x*x + y;
+}
+
+// RK2 step loop of RungeKutta2nd::solve; output(x, y, k1, k2) is called for every step
+template <class Output>
+double integrateRK2(double x0, double y0, double h, long long steps, Output output) {
+    double x = x0, y = y0;
+    for (long long n = 0; n < steps; n++) {
+        double k1 = h * f(x, y);
+        double k2 = h * f(x + h, y + k1);
+        y = y + 0.5 * (k1 + k2);
+        x = x0 + (n + 1) * h;
+        output(x, y, k1, k2);
+    }
+    return y;
+}
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const long long steps = 10000000;
+    const double h = 1.0 / steps;
+    const string binaryPath = "trajectory.bin", textPath = "trajectory.txt";
+
+    cout << "=== TRAJECTORY OUTPUT COST: RK2 ON dy/dx = x² + y, " << steps << " STEPS ===" << endl;
+    cout << "Every step records (x, y, k₁, k₂)" << endl << endl;
+    cout << setw(40) << left << "output" << right << setw(14) << "solver (s)" << setw(13) << "total (s)"
+         << setw(14) << "file (MB)" << setw(10) << "records" << endl;
+    cout << string(91, '-') << endl;
+
+    auto start = chrono::steady_clock::now();
+    double sink = integrateRK2(0, 1, h, steps, [](double, double, double, double) {});
+    double t = secondsSince(start);
+    cout << setw(40) << left << "none" << right << setw(14) << fixed << setprecision(3) << t << setw(13) << t
+         << setw(14) << "-" << setw(10) << 0 << endl;
+
+    // Text output as in RungeKutta2nd::solve, measured on 1/20 of the steps and scaled
+    {
+        const long long textSteps = steps / 20;
+        ofstream out(textPath);
+        start = chrono::steady_clock::now();
+        integrateRK2(0, 1, h, textSteps, [&](double x, double y, double k1, double k2) {
+            out << setw(8) << fixed << setprecision(3) << x << setw(10) << setprecision(4) << y
+                << setw(10) << k1 << setw(10) << k2 << endl;
+        });
+        t = secondsSince(start) * 20;
+        out.close();
+        struct stat st;
+        stat(textPath.c_str(), &st);
+        cout << setw(40) << left << "setw/setprecision text + endl (scaled)" << right << setw(14) << t << setw(13) << t
+             << setw(14) << setprecision(1) << st.st_size * 20 / 1e6 << setw(10) << steps << endl;
+        remove(textPath.c_str());
+    }
+
+    struct Configuration {
+        string name;
+        WriterOptions options;
+    };
+    vector<Configuration> configurations(4);
+    configurations[0].name = "async binary, raw";
+    configurations[0].options.compress = false;
+    configurations[1].name = "async binary, compressed";
+    configurations[2].name = "async binary, compressed, every 10th";
+    configurations[2].options.decimation = 10;
+    configurations[3].name = "async binary, raw, drop on overflow";
+    configurations[3].options.compress = false;
+    configurations[3].options.overflow = OverflowPolicy::Drop;
+
+    for (const Configuration& config : configurations) {
+        start = chrono::steady_clock::now();
+        TrajectoryWriter writer(binaryPath, 4, config.options);
+        if (!writer.isOpen()) return 1;
+        double solverTime;
+        {
+            auto solverStart = chrono::steady_clock::now();
+            integrateRK2(0, 1, h, steps, [&](double x, double y, double k1, double k2) {
+                double row[4] = {x, y, k1, k2};
+                writer.record(row);
+            });
+            solverTime = secondsSince(solverStart);
+        }
+        writer.close();
+        t = secondsSince(start);
+        const WriterStats& s = writer.statistics();
+        cout << setw(40) << left << config.name << right << setw(14) << setprecision(3) << solverTime << setw(13) << t
+             << setw(14) << setprecision(1) << s.writtenBytes / 1e6 << setw(10) << s.recorded;
+        if (s.dropped > 0) cout << "  (" << s.dropped << " dropped)";
+        cout << endl;
+    }
+
+    cout << "\n=== MEMORY-MAPPED READER ===" << endl;
+    {
+        WriterOptions options;
+        TrajectoryWriter writer(binaryPath, 4, options);
+        double yFinal = integrateRK2(0, 1, h, steps, [&](double x, double y, double k1, double k2) {
+            double row[4] = {x, y, k1, k2};
+            writer.record(row);
+        });
+        writer.close();
+        const WriterStats& s = writer.statistics();
+
+        start = chrono::steady_clock::now();
+        TrajectoryReader reader(binaryPath);
+        if (!reader.isOpen()) return 1;
+        vector<vector<double>> cols = reader.readAll();
+        t = secondsSince(start);
+        if (cols.empty() || cols[0].empty()) return 1;
+
+        // Replay the integration and compare bit for bit
+        long long mismatches = 0, index = 0;
+        integrateRK2(0, 1, h, steps, [&](double x, double y, double k1, double k2) {
+            if (cols[0][index] != x || cols[1][index] != y || cols[2][index] != k1 || cols[3][index] != k2) mismatches++;
+            index++;
+        });
+        cout << "Compression ratio " << setprecision(2) << static_cast<double>(s.rawBytes) / s.writtenBytes
+             << ", decoded " << cols[0].size() << " records × " << reader.numColumns() << " columns in "
+             << setprecision(3) << t << " s" << endl;
+        cout << "Bit-exact mismatches against a replay: " << mismatches << endl;
+        cout << "y(1) = " << setprecision(10) << cols[1].back() << ", exact -1 - 2 - 2 + 3e = "
+             << -1.0 - 2 - 2 + 3 * exp(1.0) << ", solver returned " << yFinal << endl;
+
+        // A truncated copy must be reported, not read past the end of the mapping
+        if (truncate(binaryPath.c_str(), s.writtenBytes / 2) == 0) {
+            TrajectoryReader damaged(binaryPath);
+            size_t decoded = damaged.readAll().size();
+            cout << "Truncated to half: decoded " << decoded << " columns" << endl;
+        }
+        remove(binaryPath.c_str());
+    }
+
+    cout << "\n=== WRITE ERRORS ===" << endl;
+    {
+        // An unopenable path leaves a writer that ignores records; /dev/full accepts the open and fails every write
+        WriterOptions options;
+        options.ringChunks = 5;  // rounded up to 8 ring slots
+        for (const string& path : {string("/nonexistent/trajectory.bin"), string("/dev/full")}) {
+            TrajectoryWriter writer(path, 4, options);
+            bool opened = writer.isOpen();
+            integrateRK2(0, 1, h, 100000, [&](double x, double y, double k1, double k2) {
+                double row[4] = {x, y, k1, k2};
+                writer.record(row);
+            });
+            bool ok = writer.close();
+            cout << path << ": open " << (opened ? "succeeded" : "failed") << ", close " << (ok ? "succeeded" : "failed") << endl;
+        }
+    }
+
+    if (sink == 0) cout << endl;
+    return 0;
+}
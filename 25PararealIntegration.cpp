@@ -0,0 +1,230 @@
+/*Parareal: Parallel-in-Time Integration
+A single long trajectory is serial by nature: step n+1 needs step n. Parareal splits [t₀, T] into N time slices
+[Tₙ, Tₙ₊₁] and uses two propagators over a slice:
+G(Tₙ, U) — coarse and cheap (a few Euler or RK2 steps), F(Tₙ, U) — fine and accurate (many RK4 steps).
+
+Initial guess:  U⁰ₙ₊₁ = G(Tₙ, U⁰ₙ)                         (serial, cheap)
+Iteration k:    F(Tₙ, Uᵏₙ) for all slices                    (independent: runs in parallel)
+                Uᵏ⁺¹ₙ₊₁ = G(Tₙ, Uᵏ⁺¹ₙ) + F(Tₙ, Uᵏₙ) - G(Tₙ, Uᵏₙ)   (serial correction sweep, cheap)
+
+After k iterations the first k slices agree exactly with serial fine integration, so the method always converges
+in at most N iterations; it pays off when it converges in K ≪ N iterations. With P cores and equal slices:
+speedup ≈ T_F / (K·(T_F·⌈N/P⌉/N + T_G) + T_G),  where T_F and T_G are the serial fine and coarse times.
+Slices below k are already exact and are not recomputed.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+using RHS = function<double(double, double)>;
+using Propagator = function<double(double, double, double)>;  // (t0, y0, t1) -> y(t1)
+
+Propagator eulerPropagator(RHS f, int steps) {
+    return [f, steps](double t0, double y, double t1) {
+        double h = (t1 - t0) / steps;
+        for (int i = 0; i < steps; i++) y += h * f(t0 + i * h, y);
+        return y;
+    };
+}
+
+// RK2 (Heun) as in RungeKutta2nd::solve (11.cpp)
+Propagator rk2Propagator(RHS f, int steps) {
+    return [f, steps](double t0, double y, double t1) {
+        double h = (t1 - t0) / steps;
+        for (int i = 0; i < steps; i++) {
+            double x = t0 + i * h;
+            double k1 = h * f(x, y);
+            double k2 = h * f(x + h, y + k1);
+            y += 0.5 * (k1 + k2);
+        }
+        return y;
+    };
+}
+
+// Classical RK4 as in DenseRungeKutta4 (13.cpp)
+Propagator rk4Propagator(RHS f, int steps) {
+    return [f, steps](double t0, double y, double t1) {
+        double h = (t1 - t0) / steps;
+        for (int i = 0; i < steps; i++) {
+            double x = t0 + i * h;
+            double k1 = h * f(x, y);
+            double k2 = h * f(x + h/2, y + k1/2);
+            double k3 = h * f(x + h/2, y + k2/2);
+            double k4 = h * f(x + h, y + k3);
+            y += (k1 + 2*k2 + 2*k3 + k4) / 6;
+        }
+        return y;
+    };
+}
+
+struct PararealResult {
+    vector<double> U;           // solution at the slice boundaries T₀..T_N
+    int iterations = 0;
+    bool converged = false;
+    double seconds = 0;
+    double fineSeconds = 0;     // wall time spent in the parallel fine sweeps
+    double coarseSeconds = 0;   // wall time spent in the serial coarse sweeps
+};
+
+class Parareal {
+private:
+    Propagator coarse, fine;
+    int slices;
+    double tolerance;
+    int maxIterations;
+    int numThreads;
+
+public:
+    Parareal(Propagator G, Propagator F, int numSlices, double tol = 1e-10, int maxIter = 0, int threads = 0) {
+        coarse = G;
+        fine = F;
+        slices = numSlices;
+        tolerance = tol;
+        maxIterations = maxIter > 0 ? maxIter : numSlices;
+        numThreads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+    }
+
+    PararealResult solve(double t0, double y0, double t1) const {
+        auto start = chrono::steady_clock::now();
+        PararealResult result;
+        vector<double> T(slices + 1);
+        for (int n = 0; n <= slices; n++) T[n] = t0 + (t1 - t0) * n / slices;
+
+        vector<double>& U = result.U;
+        U.assign(slices + 1, 0);
+        vector<double> G(slices), F(slices);  // G[n] = G(Tₙ, Uₙ) and F[n] = F(Tₙ, Uₙ) of the current iterate
+        U[0] = y0;
+
+        auto coarseStart = chrono::steady_clock::now();
+        for (int n = 0; n < slices; n++) {
+            G[n] = coarse(T[n], U[n], T[n + 1]);
+            U[n + 1] = G[n];
+        }
+        result.coarseSeconds += chrono::duration<double>(chrono::steady_clock::now() - coarseStart).count();
+
+        for (int k = 0; k < maxIterations; k++) {
+            // Parallel fine sweep over the slices that are not exact yet
+            auto fineStart = chrono::steady_clock::now();
+            atomic<int> next(k);
+            auto worker = [&]() {
+                for (int n = next++; n < slices; n = next++) F[n] = fine(T[n], U[n], T[n + 1]);
+            };
+            vector<thread> pool;
+            int used = min(numThreads, slices - k);
+            for (int t = 1; t < used; t++) pool.emplace_back(worker);
+            worker();
+            for (auto& t : pool) t.join();
+            result.fineSeconds += chrono::duration<double>(chrono::steady_clock::now() - fineStart).count();
+
+            // Serial correction sweep
+            coarseStart = chrono::steady_clock::now();
+            double change = 0;
+            U[k + 1] = F[k];  // slice k starts from an exact value, so its fine result is final
+            for (int n = k + 1; n < slices; n++) {
+                double g = coarse(T[n], U[n], T[n + 1]);
+                double updated = g + F[n] - G[n];
+                G[n] = g;
+                change = max(change, abs(updated - U[n + 1]) / max(1.0, abs(updated)));
+                U[n + 1] = updated;
+            }
+            result.coarseSeconds += chrono::duration<double>(chrono::steady_clock::now() - coarseStart).count();
+            result.iterations = k + 1;
+
+            if (change < tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    int sliceCount() const { return slices; }
+};
+
+void runProblem(const string& title, const RHS& f, const function<double(double)>& exact, double t0, double t1) {
+    cout << "\n=== " << title << " ===" << endl;
+    const int slices = 64;
+    const int fineStepsPerSlice = 20000;
+    Propagator fine = rk4Propagator(f, fineStepsPerSlice);
+
+    // Serial reference: the fine propagator over the whole interval
+    auto start = chrono::steady_clock::now();
+    double ySerial = 1.0;
+    for (int n = 0; n < slices; n++) {
+        double a = t0 + (t1 - t0) * n / slices, b = t0 + (t1 - t0) * (n + 1) / slices;
+        ySerial = fine(a, ySerial, b);
+    }
+    double serialTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double exactEnd = exact(t1);
+    cout << "Serial RK4, " << slices * fineStepsPerSlice << " steps: " << fixed << setprecision(3) << serialTime
+         << " s, relative error " << scientific << setprecision(2) << abs(ySerial - exactEnd) / abs(exactEnd) << endl;
+
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    cout << setw(18) << left << "coarse G" << right << setw(6) << "K" << setw(14) << "rel. error"
+         << setw(16) << "vs serial F" << setw(11) << "time (s)" << setw(11) << "speedup";
+    for (int p : {8, 64}) cout << setw(12) << "model P=" + to_string(p);
+    cout << endl << string(100, '-') << endl;
+
+    struct Coarse {
+        string name;
+        Propagator G;
+    };
+    vector<Coarse> coarseChoices = {
+        {"Euler, 1 step", eulerPropagator(f, 1)},
+        {"Euler, 10 steps", eulerPropagator(f, 10)},
+        {"RK2, 1 step", rk2Propagator(f, 1)},
+        {"RK2, 4 steps", rk2Propagator(f, 4)}};
+
+    for (const Coarse& c : coarseChoices) {
+        Parareal solver(c.G, fine, slices, 1e-10);
+        PararealResult r = solver.solve(t0, 1.0, t1);
+        double y = r.U.back();
+
+        // Model with P cores: each fine sweep takes ⌈(N-k)/P⌉ slice times, the coarse sweeps stay serial
+        double sliceTime = serialTime / slices;
+        cout << setw(18) << left << c.name << right << setw(6) << r.iterations
+             << setw(14) << scientific << setprecision(2) << abs(y - exactEnd) / abs(exactEnd)
+             << setw(16) << abs(y - ySerial) / abs(ySerial)
+             << setw(11) << fixed << setprecision(3) << r.seconds
+             << setw(11) << setprecision(2) << serialTime / r.seconds;
+        for (int p : {8, 64}) {
+            double modelTime = r.coarseSeconds;
+            for (int k = 0; k < r.iterations; k++) modelTime += ceil(static_cast<double>(slices - k) / p) * sliceTime;
+            cout << setw(12) << serialTime / modelTime;
+        }
+        cout << (r.converged ? "" : "  (not converged)") << endl;
+    }
+    cout << "Measured with " << cores << " hardware thread(s); the model columns use the measured slice and coarse times."
+         << endl;
+}
+
+int main() {
+    cout << "=== PARAREAL PARALLEL-IN-TIME INTEGRATION ===" << endl;
+    cout << "Fine propagator F: RK4, 20000 steps per slice; 64 slices; stop when the relative update is below 1e-10" << endl;
+
+    // 11.cpp: dy/dx = x² + y, y(0) = 1, exact y = -x² - 2x - 2 + 3eˣ
+    runProblem("dy/dx = x² + y on [0, 20]", [](double x, double y) { return x*x + y; },
+               [](double x) { return -x*x - 2*x - 2 + 3*exp(x); }, 0.0, 20.0);
+
+    // 13.cpp: dy/dx = -y + eˣ, y(0) = 1, exact y = cosh x
+    runProblem("dy/dx = -y + eˣ on [0, 20]", [](double x, double y) { return -y + exp(x); },
+               [](double x) { return 0.5 * (exp(x) + exp(-x)); }, 0.0, 20.0);
+
+    // Damped, forced: y' = -y + sin(10x) over a long horizon (the exact solution has no growing part)
+    runProblem("dy/dx = -y + sin(10x) on [0, 200]", [](double x, double y) { return -y + sin(10 * x); },
+               [](double x) {
+                   double a = 1.0 / 101;  // particular solution (sin 10x - 10 cos 10x)/101 plus 1 + 10/101 e⁻ˣ
+                   return a * (sin(10 * x) - 10 * cos(10 * x)) + (1 + 10 * a) * exp(-x);
+               }, 0.0, 200.0);
+
+    return 0;
+}
@@ -0,0 +1,436 @@
+/*Variance Reduction for Monte Carlo Estimators
+Plain Monte Carlo (estimatePi in 12.cpp, buffonsNeedle in 14.cpp) has standard error σ/√N. Variance reduction
+changes how the points are drawn, or what is averaged, so that the same N gives a smaller error. Equivalently, the
+estimator behaves like plain sampling with N·(σ²_plain / σ²_reduced) samples.
+
+Stratified sampling: split [0, 1)² into an mx × my grid and draw one jittered point per cell. The variance across
+                     cells is removed, and only the variance within cells remains.
+Latin hypercube:     every coordinate axis is split into N intervals and each interval holds exactly one point
+                     (independent random permutations per axis). This removes the variance of the additive
+                     (one-dimensional) part of f.
+Antithetic pairs:    evaluate f(u) and f(1 - u) and average them. This helps when f is monotone in u, because
+                     the two values are then negatively correlated.
+Control variates:    with functions g₁..g_K of known mean μ, estimate  mean(f) - Σ βₖ (mean(gₖ) - μₖ).
+                     The optimal β solves Cov(g, g) β = Cov(g, f). The covariances are accumulated online, and
+                     each replica uses the β fitted from the replicas before it, so its correction is unbiased.
+                     The first replica fits β on its own samples.
+
+Error bars come from R independent replicas. Stratified and Latin hypercube points are not independent, so the
+sample variance within one run would be wrong. The per-sample variance is σ²_reduced = N·Var(replica means), and a
+plain-sampling pilot run measures σ²_plain. The reduction factor σ²_plain / σ²_reduced multiplied by the raw
+samples per second gives the effective samples per second: the plain rate that would reach the same error.
+
+Domains: points in [0, 1)² are mapped linearly onto [lo₀, hi₀] × [lo₁, hi₁], e.g. the unit square of 12.cpp or the
+(position, angle) domain [0, d/2] × [0, π/2] of 14.cpp. Estimates are means of f over the domain.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+// xoshiro256+ seeded by splitmix64, as in VectorNeedleKernel (14.cpp)
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit Xoshiro256(uint64_t seed) {
+        for (int i = 0; i < 4; i++) s[i] = splitmix64(seed);
+    }
+
+    uint64_t next() {
+        uint64_t result = s[0] + s[3];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }  // [0, 1)
+
+    uint64_t below(uint64_t n) { return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64); }
+};
+
+enum class Sampling { Plain, Stratified, LatinHypercube };
+
+struct Domain2D {
+    double lo[2], hi[2];
+};
+
+struct ControlVariate {
+    function<double(double, double)> g;
+    double mean;  // exact mean of g over the domain
+};
+
+struct VarianceReport {
+    double estimate;            // mean over the replicas
+    double standardError;       // standard deviation of the replica estimates / √R
+    long long evaluations;      // calls of f, over all replicas
+    double seconds;
+    double reductionFactor;     // σ²_plain / σ²_reduced
+    double samplesPerSecond;
+    double effectiveSamplesPerSecond;
+    vector<double> beta;        // final control-variate coefficients
+};
+
+class VarianceReducedEstimator {
+private:
+    Domain2D domain;
+    Sampling sampling = Sampling::Plain;
+    bool antithetic = false;
+    vector<ControlVariate> controls;
+    int replicas;
+    uint64_t seed;
+    long long pilotSamples = 1 << 18;
+
+    // Online co-moments of the sample units (f, g₁..g_K). Each replica is summarized in two passes (means, then
+    // centred products) and merged into the running totals with the pairwise formula of Chan et al.
+    struct CoMoments {
+        long long count = 0;
+        double meanF = 0;
+        vector<double> meanG, cgf;   // Σ (g - ḡ)(f - f̄)
+        vector<double> cgg;          // Σ (gᵢ - ḡᵢ)(gⱼ - ḡⱼ), K × K row-major
+
+        void reset(int k) {
+            count = 0;
+            meanF = 0;
+            meanG.assign(k, 0);
+            cgf.assign(k, 0);
+            cgg.assign(static_cast<size_t>(k) * k, 0);
+        }
+
+        // n units f[i] with controls g[i·K .. i·K + K - 1]
+        void addBatch(const double* f, const double* g, long long n) {
+            int k = static_cast<int>(meanG.size());
+            CoMoments batch;
+            batch.reset(k);
+            batch.count = n;
+            for (long long i = 0; i < n; i++) {
+                batch.meanF += f[i];
+                for (int j = 0; j < k; j++) batch.meanG[j] += g[i * k + j];
+            }
+            batch.meanF /= n;
+            for (int j = 0; j < k; j++) batch.meanG[j] /= n;
+            double dg[8];
+            for (long long i = 0; i < n; i++) {
+                double df = f[i] - batch.meanF;
+                for (int j = 0; j < k; j++) dg[j] = g[i * k + j] - batch.meanG[j];
+                for (int a = 0; a < k; a++) {
+                    batch.cgf[a] += dg[a] * df;
+                    for (int b = 0; b < k; b++) batch.cgg[a * k + b] += dg[a] * dg[b];
+                }
+            }
+
+            long long total = count + n;
+            double w = static_cast<double>(count) * n / total;
+            double deltaF = batch.meanF - meanF;
+            for (int a = 0; a < k; a++) {
+                double deltaA = batch.meanG[a] - meanG[a];
+                cgf[a] += batch.cgf[a] + w * deltaA * deltaF;
+                for (int b = 0; b < k; b++) {
+                    cgg[a * k + b] += batch.cgg[a * k + b] + w * deltaA * (batch.meanG[b] - meanG[b]);
+                }
+            }
+            meanF += deltaF * n / total;
+            for (int a = 0; a < k; a++) meanG[a] += (batch.meanG[a] - meanG[a]) * n / total;
+            count = total;
+        }
+
+        // β = Cgg⁻¹ Cgf by Gaussian elimination with partial pivoting. A control with (near) zero variance, such as
+        // a linear g under antithetic pairing, gets β = 0.
+        vector<double> beta() const {
+            int k = static_cast<int>(meanG.size());
+            vector<double> b(k, 0);
+            if (count < k + 2) return b;
+            vector<double> a(cgg);
+            vector<double> rhs(cgf);
+            vector<bool> active(k, true);
+            double scale = 0;
+            for (int i = 0; i < k; i++) scale = max(scale, a[i * k + i]);
+            for (int i = 0; i < k; i++) {
+                if (a[i * k + i] <= 1e-12 * scale || scale == 0) {
+                    active[i] = false;
+                    for (int j = 0; j < k; j++) a[i * k + j] = a[j * k + i] = 0;
+                    a[i * k + i] = 1;
+                    rhs[i] = 0;
+                }
+            }
+            for (int col = 0; col < k; col++) {
+                int pivot = col;
+                for (int r = col + 1; r < k; r++) {
+                    if (abs(a[r * k + col]) > abs(a[pivot * k + col])) pivot = r;
+                }
+                if (abs(a[pivot * k + col]) < 1e-300) return vector<double>(k, 0);
+                if (pivot != col) {
+                    for (int j = 0; j < k; j++) swap(a[col * k + j], a[pivot * k + j]);
+                    swap(rhs[col], rhs[pivot]);
+                }
+                for (int r = col + 1; r < k; r++) {
+                    double factor = a[r * k + col] / a[col * k + col];
+                    for (int j = col; j < k; j++) a[r * k + j] -= factor * a[col * k + j];
+                    rhs[r] -= factor * rhs[col];
+                }
+            }
+            for (int i = k - 1; i >= 0; i--) {
+                double sum = rhs[i];
+                for (int j = i + 1; j < k; j++) sum -= a[i * k + j] * b[j];
+                b[i] = sum / a[i * k + i];
+            }
+            for (int i = 0; i < k; i++) {
+                if (!active[i]) b[i] = 0;
+            }
+            return b;
+        }
+    };
+
+    // n points in [0, 1)², written as (u[i], v[i])
+    void generate(Sampling scheme, long long n, Xoshiro256& rng, vector<double>& u, vector<double>& v) const {
+        u.resize(n);
+        v.resize(n);
+        if (scheme == Sampling::Plain) {
+            for (long long i = 0; i < n; i++) {
+                u[i] = rng.uniform();
+                v[i] = rng.uniform();
+            }
+        } else if (scheme == Sampling::Stratified) {
+            // mx × my cells with one jittered point each; the fewer than mx left-over points are drawn plainly
+            long long mx = max(1LL, static_cast<long long>(sqrt(static_cast<double>(n))));
+            long long my = n / mx;
+            long long i = 0;
+            for (long long a = 0; a < mx; a++) {
+                for (long long b = 0; b < my; b++, i++) {
+                    u[i] = (a + rng.uniform()) / mx;
+                    v[i] = (b + rng.uniform()) / my;
+                }
+            }
+            for (; i < n; i++) {
+                u[i] = rng.uniform();
+                v[i] = rng.uniform();
+            }
+        } else {
+            // Latin hypercube: point i lies in interval i of u and in interval perm(i) of v
+            vector<long long> perm(n);
+            for (long long i = 0; i < n; i++) perm[i] = i;
+            for (long long i = n - 1; i > 0; i--) swap(perm[i], perm[rng.below(i + 1)]);
+            for (long long i = 0; i < n; i++) {
+                u[i] = (i + rng.uniform()) / n;
+                v[i] = (perm[i] + rng.uniform()) / n;
+            }
+        }
+    }
+
+public:
+    VarianceReducedEstimator(const Domain2D& region, int numReplicas = 32, uint64_t baseSeed = 20240601) {
+        domain = region;
+        replicas = max(2, numReplicas);
+        seed = baseSeed;
+    }
+
+    VarianceReducedEstimator& withSampling(Sampling scheme) {
+        sampling = scheme;
+        return *this;
+    }
+
+    VarianceReducedEstimator& withAntithetic(bool enabled = true) {
+        antithetic = enabled;
+        return *this;
+    }
+
+    VarianceReducedEstimator& withControl(const function<double(double, double)>& g, double mean) {
+        if (controls.size() >= 8) {
+            cout << "At most 8 control variates are supported; ignoring the extra one." << endl;
+            return *this;
+        }
+        controls.push_back({g, mean});
+        return *this;
+    }
+
+    // Per-sample variance of f under plain sampling, from a pilot run (not counted in the timings)
+    double plainVariance(const function<double(double, double)>& f) const {
+        Xoshiro256 rng(seed ^ 0x5DEECE66Dull);
+        double mean = 0, m2 = 0;
+        for (long long i = 1; i <= pilotSamples; i++) {
+            double x = domain.lo[0] + (domain.hi[0] - domain.lo[0]) * rng.uniform();
+            double y = domain.lo[1] + (domain.hi[1] - domain.lo[1]) * rng.uniform();
+            double value = f(x, y);
+            double delta = value - mean;
+            mean += delta / i;
+            m2 += delta * (value - mean);
+        }
+        return m2 / (pilotSamples - 1);
+    }
+
+    // Mean of f over the domain from R replicas of samplesPerReplica evaluations each
+    VarianceReport estimate(const function<double(double, double)>& f, long long samplesPerReplica) const {
+        double sigma2Plain = plainVariance(f);
+        auto start = chrono::steady_clock::now();
+
+        int k = static_cast<int>(controls.size());
+        long long units = antithetic ? samplesPerReplica / 2 : samplesPerReplica;
+        long long evaluationsPerReplica = antithetic ? 2 * units : units;
+        double wx = domain.hi[0] - domain.lo[0], wy = domain.hi[1] - domain.lo[1];
+
+        CoMoments history;     // replicas 0..r-1
+        history.reset(k);
+        vector<double> u, v, fUnit(units), gUnit(static_cast<size_t>(units) * max(k, 1));
+        vector<double> replicaEstimates(replicas);
+        vector<double> beta(k, 0);
+
+        for (int r = 0; r < replicas; r++) {
+            Xoshiro256 rng(seed + 0x9E3779B97F4A7C15ull * (r + 1));
+            generate(sampling, units, rng, u, v);
+
+            double sumF = 0;
+            vector<double> sumG(k, 0);
+            for (long long i = 0; i < units; i++) {
+                double x = domain.lo[0] + wx * u[i], y = domain.lo[1] + wy * v[i];
+                double value = f(x, y);
+                double* g = &gUnit[static_cast<size_t>(i) * max(k, 1)];
+                for (int j = 0; j < k; j++) g[j] = controls[j].g(x, y);
+                if (antithetic) {
+                    double xa = domain.lo[0] + wx * (1 - u[i]), ya = domain.lo[1] + wy * (1 - v[i]);
+                    value = 0.5 * (value + f(xa, ya));
+                    for (int j = 0; j < k; j++) g[j] = 0.5 * (g[j] + controls[j].g(xa, ya));
+                }
+                fUnit[i] = value;
+                sumF += value;
+                for (int j = 0; j < k; j++) sumG[j] += g[j];
+            }
+
+            double replicaEstimate = sumF / units;
+            if (k > 0) {
+                if (r == 0) {
+                    history.addBatch(fUnit.data(), gUnit.data(), units);
+                    beta = history.beta();
+                } else {
+                    beta = history.beta();
+                    history.addBatch(fUnit.data(), gUnit.data(), units);
+                }
+                for (int j = 0; j < k; j++) replicaEstimate -= beta[j] * (sumG[j] / units - controls[j].mean);
+            }
+            replicaEstimates[r] = replicaEstimate;
+        }
+
+        VarianceReport report;
+        report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        report.evaluations = evaluationsPerReplica * replicas;
+        double mean = 0;
+        for (double e : replicaEstimates) mean += e;
+        mean /= replicas;
+        double var = 0;
+        for (double e : replicaEstimates) var += (e - mean) * (e - mean);
+        var /= replicas - 1;
+        report.estimate = mean;
+        report.standardError = sqrt(var / replicas);
+        double sigma2Reduced = var * evaluationsPerReplica;
+        report.reductionFactor = sigma2Reduced > 0 ? sigma2Plain / sigma2Reduced : INFINITY;
+        report.samplesPerSecond = report.evaluations / report.seconds;
+        report.effectiveSamplesPerSecond = report.samplesPerSecond * report.reductionFactor;
+        report.beta = history.beta();
+        return report;
+    }
+};
+
+struct Configuration {
+    string name;
+    Sampling sampling;
+    bool antithetic;
+    bool useControls;
+};
+
+void compareSchemes(const string& title, const Domain2D& domain, const function<double(double, double)>& f,
+                    const vector<ControlVariate>& controls, const function<double(double)>& toAnswer, double exact,
+                    long long samplesPerReplica) {
+    cout << "\n=== " << title << " ===" << endl;
+    cout << setw(34) << left << "scheme" << right << setw(12) << "estimate" << setw(11) << "|error|" << setw(11)
+         << "std. err." << setw(10) << "factor" << setw(12) << "Msamples/s" << setw(14) << "effective M/s" << endl;
+    cout << string(104, '-') << endl;
+
+    vector<Configuration> configurations = {
+        {"plain", Sampling::Plain, false, false},
+        {"antithetic", Sampling::Plain, true, false},
+        {"control variates", Sampling::Plain, false, true},
+        {"stratified", Sampling::Stratified, false, false},
+        {"Latin hypercube", Sampling::LatinHypercube, false, false},
+        {"stratified + control variates", Sampling::Stratified, false, true},
+        {"LHS + antithetic + controls", Sampling::LatinHypercube, true, true}};
+
+    for (const Configuration& c : configurations) {
+        VarianceReducedEstimator estimator(domain, 32);
+        estimator.withSampling(c.sampling).withAntithetic(c.antithetic);
+        if (c.useControls) {
+            for (const ControlVariate& cv : controls) estimator.withControl(cv.g, cv.mean);
+        }
+        VarianceReport r = estimator.estimate(f, samplesPerReplica);
+        double answer = toAnswer(r.estimate);
+        // Delta method: the answer's standard error is |d answer / d mean| · se(mean)
+        double h = 1e-7 * max(1.0, abs(r.estimate));
+        double slope = (toAnswer(r.estimate + h) - toAnswer(r.estimate - h)) / (2 * h);
+        cout << setw(34) << left << c.name << right << fixed << setprecision(6) << setw(12) << answer
+             << scientific << setprecision(2) << setw(11) << abs(answer - exact) << setw(11)
+             << abs(slope) * r.standardError << fixed << setprecision(1) << setw(10) << r.reductionFactor
+             << setw(12) << r.samplesPerSecond / 1e6 << setw(14) << r.effectiveSamplesPerSecond / 1e6 << endl;
+    }
+}
+
+int main() {
+    cout << "=== VARIANCE REDUCTION: STRATIFIED, LATIN HYPERCUBE, ANTITHETIC, CONTROL VARIATES ===" << endl;
+    cout << "32 replicas of 2^16 evaluations each; factor = σ²_plain / σ²_reduced per evaluation;" << endl;
+    cout << "effective M/s = the plain sampling rate that would reach the same error" << endl;
+    const long long n = 1 << 16;
+
+    // estimatePi (12.cpp): the quarter-circle indicator on the unit square, mean π/4.
+    // Controls: x² + y² (mean 2/3) and x + y (mean 1), both decreasing the chance of being inside.
+    Domain2D unitSquare = {{0, 0}, {1, 1}};
+    compareSchemes("π FROM THE QUARTER CIRCLE (12.cpp), unit square", unitSquare,
+                   [](double x, double y) { return (x*x + y*y <= 1.0) ? 1.0 : 0.0; },
+                   {{[](double x, double y) { return x*x + y*y; }, 2.0 / 3},
+                    {[](double x, double y) { return x + y; }, 1.0}},
+                   [](double mean) { return 4 * mean; }, M_PI, n);
+
+    // buffonsNeedle (14.cpp), l = d = 1: x ∈ [0, d/2], θ ∈ [0, π/2], crossing when x ≤ (l/2) sin θ, mean 2l/(πd).
+    // Controls: the cubic t(3 - t²)/2 ≈ sin θ with t = 2θ/π (mean 5/8), and the position x (mean d/4).
+    const double l = 1.0, d = 1.0;
+    Domain2D needle = {{0, 0}, {d / 2, M_PI / 2}};
+    compareSchemes("π FROM BUFFON'S NEEDLE (14.cpp), (position, angle) domain", needle,
+                   [l](double x, double theta) { return (x <= 0.5 * l * sin(theta)) ? 1.0 : 0.0; },
+                   {{[](double, double theta) {
+                         double t = theta / (M_PI / 2);
+                         return 0.5 * t * (3 - t * t);
+                     }, 5.0 / 8},
+                    {[](double x, double) { return x; }, d / 4}},
+                   [l, d](double p) { return 2 * l / (p * d); }, M_PI, n);
+
+    // Smooth integrand: e^-(x² + y²) on the unit square, exact mean (√π/2 · erf 1)²
+    double exactSmooth = pow(sqrt(M_PI) / 2 * erf(1.0), 2);
+    compareSchemes("SMOOTH e^-(x² + y²) ON THE UNIT SQUARE", unitSquare,
+                   [](double x, double y) { return exp(-(x*x + y*y)); },
+                   {{[](double x, double y) { return 1 - x*x - y*y; }, 1.0 / 3}},
+                   [](double mean) { return mean; }, exactSmooth, n);
+
+    cout << "\nStratification removes the variance between cells, so it gains most on smooth integrands; on" << endl;
+    cout << "indicators only the cells cut by the boundary keep variance. Control variates help as far as a" << endl;
+    cout << "linear combination of the controls tracks f." << endl;
+
+    return 0;
+}
@@ -0,0 +1,420 @@
+/*N-Dimensional Monte Carlo Integration and VEGAS
+Tensor-product quadrature (the trapezoidal rule of 3.cpp, or Gauss-Legendre, applied once per axis) needs m points
+per axis, so mᵈ evaluations in total. In d = 10, even m = 5 already costs about 10⁷ evaluations, and d = 20 allows
+only m = 2. Monte Carlo has error σ/√N in any dimension:
+I = V·E[f(X)],  X uniform on [a, b] ⊂ ℝᵈ,   Î = V·(1/N)Σ f(Xᵢ),   se(Î) = V·s/√N
+The constant σ is what grows: a function concentrated in a small part of the box makes most uniform points
+worthless.
+
+VEGAS (Lepage 1978) importance sampling with a separable density p(x) = ∏ pⱼ(xⱼ):
+- Each axis has a grid of B bins of unequal width Δᵢ. A point picks a bin uniformly along every axis and a uniform
+  position inside it, so pⱼ = 1/(B·Δᵢ), and f(x)/p(x) = f(x)·∏ B·Δᵢ is averaged.
+- During an iteration, Σ (f/p)² is accumulated for every bin of every axis. This marginal tells where |f| is large
+  along that axis.
+- Refinement: the marginals are smoothed over neighbouring bins, and bin i gets the weight ((rᵢ - 1)/ln rᵢ)^α,
+  where rᵢ is its share of the total (α < 2 damps the update). New edges are placed so that every bin holds an
+  equal weight. Bins shrink where f is large, which concentrates the points there.
+- Iterations k are combined by inverse-variance weighting: Î = Σ Îₖ/σₖ² / Σ 1/σₖ², with σ = (Σ 1/σₖ²)^-1/2.
+  χ²/dof = Σ (Îₖ - Î)²/σₖ² / (K - 1) should stay near 1. A large value means the early grids were still poor.
+  Warm-up iterations only train the grid and are discarded.
+
+Parallelism: an iteration is split into blocks of 2¹⁴ points. Threads claim blocks through an atomic counter, and
+each block has its own generator, seeded by (seed, iteration, block). Block sums and bin histograms are reduced in
+block order, so the result does not depend on the thread count.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+using Integrand = function<double(const double*)>;
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256+ (as in 14.cpp); one instance per block
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+public:
+    explicit Xoshiro256(uint64_t seed) {
+        for (int i = 0; i < 4; i++) s[i] = seed = splitmix64(seed);
+    }
+
+    double uniform() {
+        uint64_t result = s[0] + s[3];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 45) | (s[3] >> 19);
+        return (result >> 11) * 0x1.0p-53;
+    }
+};
+
+struct IntegrationResult {
+    double integral;
+    double error;           // one standard deviation
+    long long evaluations;
+    double seconds;
+    double chi2PerDof = 0;  // VEGAS only
+};
+
+// Runs body(block) for blocks 0..blocks-1 on numThreads threads
+void parallelBlocks(int blocks, int numThreads, const function<void(int)>& body) {
+    atomic<int> next(0);
+    auto worker = [&]() {
+        for (int b = next++; b < blocks; b = next++) body(b);
+    };
+    vector<thread> pool;
+    for (int t = 1; t < min(numThreads, blocks); t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+class MonteCarloIntegrator {
+private:
+    vector<double> lower, upper;
+    int dims;
+    int numThreads;
+    uint64_t seed;
+
+public:
+    static const int blockSize = 1 << 14;
+
+    MonteCarloIntegrator(const vector<double>& a, const vector<double>& b, int threads = 0, uint64_t baseSeed = 0x5EED) {
+        lower = a;
+        upper = b;
+        dims = static_cast<int>(a.size());
+        numThreads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+        seed = baseSeed;
+    }
+
+    IntegrationResult integrate(const Integrand& f, long long samples) const {
+        auto start = chrono::steady_clock::now();
+        double volume = 1;
+        for (int d = 0; d < dims; d++) volume *= upper[d] - lower[d];
+        int blocks = static_cast<int>((samples + blockSize - 1) / blockSize);
+        vector<double> sum(blocks), sum2(blocks);
+
+        parallelBlocks(blocks, numThreads, [&](int b) {
+            Xoshiro256 rng(seed ^ splitmix64(b));
+            long long count = min<long long>(blockSize, samples - static_cast<long long>(b) * blockSize);
+            vector<double> x(dims);
+            double s = 0, s2 = 0;
+            for (long long i = 0; i < count; i++) {
+                for (int d = 0; d < dims; d++) x[d] = lower[d] + (upper[d] - lower[d]) * rng.uniform();
+                double value = f(x.data());
+                s += value;
+                s2 += value * value;
+            }
+            sum[b] = s;
+            sum2[b] = s2;
+        });
+
+        double s = 0, s2 = 0;
+        for (int b = 0; b < blocks; b++) {
+            s += sum[b];
+            s2 += sum2[b];
+        }
+        double mean = s / samples;
+        double var = max(0.0, (s2 / samples - mean * mean) / (samples - 1));
+
+        IntegrationResult result;
+        result.integral = volume * mean;
+        result.error = volume * sqrt(var);
+        result.evaluations = samples;
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+};
+
+class VegasIntegrator {
+private:
+    vector<double> lower, upper;
+    int dims;
+    int bins;
+    double alpha;
+    int numThreads;
+    uint64_t seed;
+    vector<double> edges;  // edges[d * (bins + 1) + i] in [0, 1]
+
+    // Lepage's rebinning of axis d from the accumulated Σ (f/p)² per bin
+    void refine(int d, const double* binWeight) {
+        double* e = &edges[static_cast<size_t>(d) * (bins + 1)];
+        vector<double> smooth(bins);
+        double total = 0;
+        for (int i = 0; i < bins; i++) {
+            double left = i > 0 ? binWeight[i - 1] : binWeight[i];
+            double right = i + 1 < bins ? binWeight[i + 1] : binWeight[i];
+            smooth[i] = (left + binWeight[i] + right) / 3;
+            total += smooth[i];
+        }
+        if (total <= 0) return;
+
+        vector<double> w(bins);
+        double sumW = 0;
+        for (int i = 0; i < bins; i++) {
+            double r = smooth[i] / total;
+            w[i] = (r <= 0 || r >= 1) ? 0 : pow((r - 1) / log(r), alpha);
+            sumW += w[i];
+        }
+        if (sumW <= 0) return;
+
+        vector<double> updated(bins + 1);
+        updated[0] = 0;
+        updated[bins] = 1;
+        double perBin = sumW / bins, accumulated = 0;
+        int j = 0;
+        for (int k = 1; k < bins; k++) {
+            double need = k * perBin;
+            while (j < bins - 1 && accumulated + w[j] < need) accumulated += w[j++];
+            double fraction = w[j] > 0 ? min(1.0, (need - accumulated) / w[j]) : 0;
+            updated[k] = e[j] + fraction * (e[j + 1] - e[j]);
+        }
+        for (int i = 0; i <= bins; i++) e[i] = updated[i];
+    }
+
+public:
+    static const int blockSize = 1 << 14;
+
+    VegasIntegrator(const vector<double>& a, const vector<double>& b, int numBins = 50, double damping = 1.5,
+                    int threads = 0, uint64_t baseSeed = 0x5EED) {
+        lower = a;
+        upper = b;
+        dims = static_cast<int>(a.size());
+        bins = numBins;
+        alpha = damping;
+        numThreads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+        seed = baseSeed;
+        edges.resize(static_cast<size_t>(dims) * (bins + 1));
+        for (int d = 0; d < dims; d++) {
+            for (int i = 0; i <= bins; i++) edges[static_cast<size_t>(d) * (bins + 1) + i] = static_cast<double>(i) / bins;
+        }
+    }
+
+    // warmup iterations only train the grid; the next 'iterations' are combined (and keep refining the grid)
+    IntegrationResult integrate(const Integrand& f, long long samplesPerIteration, int iterations, int warmup = 5) {
+        auto start = chrono::steady_clock::now();
+        double volume = 1;
+        for (int d = 0; d < dims; d++) volume *= upper[d] - lower[d];
+        int blocks = static_cast<int>((samplesPerIteration + blockSize - 1) / blockSize);
+        size_t histogramSize = static_cast<size_t>(dims) * bins;
+        vector<double> sum(blocks), sum2(blocks), histogram(static_cast<size_t>(blocks) * histogramSize);
+
+        double weightSum = 0, weightedMean = 0, weightedSquares = 0;
+        vector<double> estimates, variances;
+        for (int it = 0; it < warmup + iterations; it++) {
+            fill(histogram.begin(), histogram.end(), 0.0);
+            parallelBlocks(blocks, numThreads, [&](int b) {
+                Xoshiro256 rng(seed ^ splitmix64((static_cast<uint64_t>(it) << 32) | static_cast<uint64_t>(b)));
+                long long count = min<long long>(blockSize, samplesPerIteration - static_cast<long long>(b) * blockSize);
+                double* hist = &histogram[static_cast<size_t>(b) * histogramSize];
+                vector<double> x(dims);
+                vector<int> bin(dims);
+                double s = 0, s2 = 0;
+                for (long long i = 0; i < count; i++) {
+                    double jacobian = volume;
+                    for (int d = 0; d < dims; d++) {
+                        double y = rng.uniform() * bins;
+                        int k = min(bins - 1, static_cast<int>(y));
+                        const double* e = &edges[static_cast<size_t>(d) * (bins + 1)];
+                        double width = e[k + 1] - e[k];
+                        x[d] = lower[d] + (upper[d] - lower[d]) * (e[k] + (y - k) * width);
+                        jacobian *= bins * width;
+                        bin[d] = k;
+                    }
+                    double value = f(x.data()) * jacobian;
+                    s += value;
+                    s2 += value * value;
+                    for (int d = 0; d < dims; d++) hist[d * bins + bin[d]] += value * value;
+                }
+                sum[b] = s;
+                sum2[b] = s2;
+            });
+
+            double s = 0, s2 = 0;
+            vector<double> total(histogramSize, 0);
+            for (int b = 0; b < blocks; b++) {
+                s += sum[b];
+                s2 += sum2[b];
+                const double* hist = &histogram[static_cast<size_t>(b) * histogramSize];
+                for (size_t i = 0; i < histogramSize; i++) total[i] += hist[i];
+            }
+            double mean = s / samplesPerIteration;
+            double var = max(1e-300, (s2 / samplesPerIteration - mean * mean) / (samplesPerIteration - 1));
+            if (it >= warmup) {
+                estimates.push_back(mean);
+                variances.push_back(var);
+                weightSum += 1 / var;
+                weightedMean += mean / var;
+                weightedSquares += mean * mean / var;
+            }
+            for (int d = 0; d < dims; d++) refine(d, &total[static_cast<size_t>(d) * bins]);
+        }
+
+        IntegrationResult result;
+        result.integral = weightedMean / weightSum;
+        result.error = 1 / sqrt(weightSum);
+        result.evaluations = samplesPerIteration * (warmup + iterations);
+        if (iterations > 1) {
+            double chi2 = 0;
+            for (size_t k = 0; k < estimates.size(); k++) {
+                chi2 += (estimates[k] - result.integral) * (estimates[k] - result.integral) / variances[k];
+            }
+            result.chi2PerDof = chi2 / (iterations - 1);
+        }
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+};
+
+// Gauss-Legendre nodes and weights on [-1, 1] by Newton's method on Pₘ
+void gaussLegendre(int m, vector<double>& nodes, vector<double>& weights) {
+    nodes.resize(m);
+    weights.resize(m);
+    for (int i = 0; i < (m + 1) / 2; i++) {
+        double z = cos(M_PI * (i + 0.75) / (m + 0.5)), dp = 0;
+        for (int iter = 0; iter < 100; iter++) {
+            double p0 = 1, p1 = 0;
+            for (int k = 1; k <= m; k++) {
+                double p2 = p1;
+                p1 = p0;
+                p0 = ((2 * k - 1) * z * p1 - (k - 1) * p2) / k;
+            }
+            dp = m * (z * p0 - p1) / (z * z - 1);
+            double dz = p0 / dp;
+            z -= dz;
+            if (abs(dz) < 1e-15) break;
+        }
+        nodes[i] = -z;
+        nodes[m - 1 - i] = z;
+        weights[i] = weights[m - 1 - i] = 2 / ((1 - z * z) * dp * dp);
+    }
+}
+
+// Tensor-product Gauss-Legendre with m points per axis: mᵈ evaluations
+IntegrationResult tensorGaussLegendre(const Integrand& f, const vector<double>& a, const vector<double>& b, int m) {
+    auto start = chrono::steady_clock::now();
+    int dims = static_cast<int>(a.size());
+    vector<double> nodes, weights;
+    gaussLegendre(m, nodes, weights);
+    vector<int> index(dims, 0);
+    vector<double> x(dims);
+    double sum = 0;
+    long long evaluations = 0;
+    while (true) {
+        double w = 1;
+        for (int d = 0; d < dims; d++) {
+            double half = 0.5 * (b[d] - a[d]);
+            x[d] = a[d] + half * (nodes[index[d]] + 1);
+            w *= half * weights[index[d]];
+        }
+        sum += w * f(x.data());
+        evaluations++;
+        int d = 0;
+        while (d < dims && ++index[d] == m) index[d++] = 0;
+        if (d == dims) break;
+    }
+    IntegrationResult result;
+    result.integral = sum;
+    result.error = NAN;
+    result.evaluations = evaluations;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void printRow(const string& method, const IntegrationResult& r, double exact) {
+    cout << setw(30) << left << method << right << scientific << setprecision(6) << setw(15) << r.integral
+         << setprecision(2) << setw(11) << abs(r.integral - exact) / abs(exact);
+    if (isnan(r.error)) cout << setw(11) << "-";
+    else cout << setw(11) << r.error / abs(exact);
+    cout << setw(12) << r.evaluations << fixed << setprecision(3) << setw(10) << r.seconds;
+    if (r.chi2PerDof > 0) cout << setprecision(2) << setw(9) << r.chi2PerDof;
+    cout << endl;
+}
+
+void compareMethods(const string& title, int dims, const Integrand& f, double exact, long long budget) {
+    cout << "\n=== " << title << ", d = " << dims << " ===" << endl;
+    cout << "Exact: " << scientific << setprecision(10) << exact << ";  budget " << budget << " evaluations" << endl;
+    cout << setw(30) << left << "method" << right << setw(15) << "estimate" << setw(11) << "rel. err." << setw(11)
+         << "rel. σ" << setw(12) << "evals" << setw(10) << "time (s)" << setw(9) << "χ²/dof" << endl;
+    cout << string(98, '-') << endl;
+    vector<double> a(dims, 0.0), b(dims, 1.0);
+
+    // Largest m with mᵈ within the budget
+    int m = 1;
+    while (pow(m + 1, dims) <= budget) m++;
+    if (m >= 2) printRow("Gauss-Legendre " + to_string(m) + "^" + to_string(dims), tensorGaussLegendre(f, a, b, m), exact);
+    else cout << setw(30) << left << "Gauss-Legendre" << right << "  2^" << dims << " points exceed the budget" << endl;
+
+    MonteCarloIntegrator plain(a, b);
+    printRow("plain Monte Carlo", plain.integrate(f, budget), exact);
+
+    VegasIntegrator vegas(a, b);
+    int warmup = 15, iterations = 10;
+    printRow("VEGAS (15 warm-up + 10)", vegas.integrate(f, budget / (warmup + iterations), iterations, warmup), exact);
+}
+
+int main() {
+    cout << "=== N-DIMENSIONAL MONTE CARLO AND VEGAS ADAPTIVE IMPORTANCE SAMPLING ===" << endl;
+    cout << "Threads: " << max(1u, thread::hardware_concurrency()) << "; rel. σ is each method's own error estimate" << endl;
+    const long long budget = 3000000;
+
+    // Narrow Gaussian peak, off centre: ∏ exp(-(xᵢ - c)²/(2s²)) / (s√(2π)) on [0, 1]ᵈ
+    const double s = 0.1, c = 0.35;
+    double axis = 0.5 * (erf((1 - c) / (s * sqrt(2.0))) + erf(c / (s * sqrt(2.0))));
+    for (int dims : {6, 10, 20}) {
+        Integrand peak = [dims, s, c](const double* x) {
+            double q = 0;
+            for (int i = 0; i < dims; i++) q += (x[i] - c) * (x[i] - c);
+            return exp(-q / (2 * s * s) - dims * log(s * sqrt(2 * M_PI)));
+        };
+        compareMethods("GAUSSIAN PEAK, width 0.1", dims, peak, pow(axis, dims), budget);
+    }
+
+    // Singular-looking product weighted towards the origin: ∏ k/(0.1 + xᵢ), k = 1/ln 11
+    for (int dims : {8}) {
+        double k = 1 / log(1.1 / 0.1);  // each axis integrates to 1
+        Integrand corner = [dims, k](const double* x) {
+            double prod = 1;
+            for (int i = 0; i < dims; i++) prod *= k / (0.1 + x[i]);
+            return prod;
+        };
+        compareMethods("PRODUCT 1/(0.1 + xᵢ), normalized", dims, corner, 1.0, budget);
+    }
+
+    // Smooth and spread out: tensor quadrature is the right tool here in low dimension
+    {
+        int dims = 6;
+        Integrand smooth = [dims](const double* x) {
+            double prod = 1;
+            for (int i = 0; i < dims; i++) prod *= 1 + 0.5 * cos(M_PI * x[i]);
+            return prod;
+        };
+        compareMethods("SMOOTH ∏ (1 + cos(πxᵢ)/2)", dims, smooth, 1.0, budget);
+    }
+
+    cout << "\nFrom d = 10 on, tensor quadrature affords only a few points per axis and misses the peak entirely," << endl;
+    cout << "while VEGAS adapts its grid to the peak and stays orders of magnitude more accurate than both plain" << endl;
+    cout << "Monte Carlo and the product rule. In d = 6 with 12 points per axis the two are comparable, and on" << endl;
+    cout << "smooth, spread-out integrands in low dimension Gauss-Legendre stays unbeatable." << endl;
+
+    return 0;
+}
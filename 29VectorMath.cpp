@@ -0,0 +1,675 @@
+/*Vectorized Elementary Functions (exp, log, sin, cos, sincos, pow)
+A loop such as  for i: y[i] = exp(x[i]) - 2*x[i]  (8.cpp) or the Buffon test with sin(angle) (14.cpp) stays scalar,
+because every iteration calls into libm. Written with only arithmetic, bit manipulation and selects, the
+same functions inline into the loop, and the compiler turns the loop into AVX2 or AVX-512 code.
+
+exp(x):  n = round(x/ln 2), r = x - n·ln 2 with ln 2 split into two parts (Cody-Waite, exact for |n| ≤ 1075),
+         |r| ≤ ln 2/2, exp(x) = 2ⁿ·P(r). The rounding uses the 1.5·2⁵² trick, so n also appears as an integer in
+         the low mantissa bits and 2ⁿ is assembled in the exponent field. 2ⁿ is applied as two halves, so results
+         down to the subnormal range stay correct.
+log(x):  x = 2ᵉ·m with m ∈ [√½, √2), f = m - 1, s = f/(2 + f), log m = 2 atanh s = f - (f²/2 - s(f²/2 + R(s²))).
+sin/cos: q = round(x·2/π), r = x - q·π/2 with π/2 in four parts (33 + 33 + 33 + 53 bits, each q·part exact
+         for |x| < 2¹⁹), subtracted one at a time with two-sums so that arguments next to a multiple of π/2 keep
+         their full relative accuracy. Taylor polynomials on |r| ≤ π/4 and a quadrant select; the 1 ulp tier
+         also uses the part δ of the reduced argument lost when rounding r. Larger |x| are recomputed with libm.
+pow:     exp(y·log x) loses |y·log x| ulp if log x is rounded to double. Here log x is kept as a double-double from
+         a table: z = c·(1 + r) with c on a 1/128 grid, log cᵢ stored in hi + lo, r exact from an error-free product
+         (splitting, so no FMA is needed). y·log x is formed as a double-double and passed to exp as x + δ.
+         Non-positive, subnormal or non-finite x, and non-finite y, go to libm.
+
+Accuracy tiers: Accuracy::Ulp1 targets ≤ 1 ulp and Accuracy::Ulp4 ≤ 4 ulp. The cheaper tier uses shorter
+polynomials; main measures both against long double libm.
+
+Runtime dispatch: the batch functions carry target_clones("avx512f", "avx2", "default"). The loader chooses the
+best clone for the running CPU (ifunc), so a plain build runs AVX-512 code where it is available and AVX2 code
+elsewhere. The kernels are compiled with -O3 settings through #pragma GCC optimize, so they vectorize at -O1 and -O2
+too. Without AVX2 the public functions fall back to scalar libm.
+Selects are written with blend() (bit masks), never as branches, so that every clone if-converts and vectorizes.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VECTOR_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VECTOR_DISPATCH
+#endif
+
+enum class Accuracy { Ulp1, Ulp4 };
+
+// From here to the batch kernels the file is compiled with -O3 settings whatever the build uses: at -O2 GCC's
+// "very cheap" vectorizer cost model rejects loops whose trip count is unknown, and the kernels would run scalar.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("O3")
+#endif
+
+inline double fromBits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, 8);
+    return value;
+}
+
+inline uint64_t toBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, 8);
+    return bits;
+}
+
+// condition ? ifTrue : ifFalse through bit masks. With a plain ?: on constant operands GCC may thread the branch
+// into constant-folded paths that can trap (such as 2⁵¹²·2⁵¹²); the loop is then no longer if-converted and
+// stays scalar.
+inline double blend(bool condition, double ifTrue, double ifFalse) {
+    uint64_t mask = -static_cast<uint64_t>(condition);
+    return fromBits((toBits(ifTrue) & mask) | (toBits(ifFalse) & ~mask));
+}
+
+// |k| < 2⁵¹ to double through the 1.5·2⁵² trick; AVX2 has no 64-bit integer to double conversion
+inline double integerToDouble(int64_t k) {
+    return fromBits(toBits(0x1.8p52) + static_cast<uint64_t>(k)) - 0x1.8p52;
+}
+
+// Error-free product a·b = p + e. The split by masking the low 27 mantissa bits makes ah·bh, ah·bl and al·bh
+// exact, so the result is the same whether or not the compiler contracts the expression into FMAs.
+inline void twoProduct(double a, double b, double& p, double& e) {
+    p = a * b;
+    double ah = fromBits(toBits(a) & 0xFFFFFFFFF8000000ull), al = a - ah;
+    double bh = fromBits(toBits(b) & 0xFFFFFFFFF8000000ull), bl = b - bh;
+    e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+}
+
+// Error-free sum a + b = s + e (Knuth)
+inline void twoSum(double a, double b, double& s, double& e) {
+    s = a + b;
+    double bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+}
+
+// exp(x + dx) for a small correction dx; Precise uses a degree-13 Taylor polynomial, otherwise degree 12
+template <bool Precise>
+inline double expCore(double x, double dx = 0) {
+    const double log2e = 1.4426950408889634;
+    const double ln2hi = 6.93147180369123816490e-01, ln2lo = 1.90821492927058770002e-10;  // fdlibm split
+    const double magic = 0x1.8p52;
+    double xc = blend(x > 709.79, 709.79, x);
+    xc = blend(x < -745.2, -745.2, xc);
+    double t = xc * log2e + magic;
+    double n = t - magic;
+    int64_t ni = static_cast<int64_t>(toBits(t) - toBits(magic));
+    double r = (xc - n * ln2hi) - n * ln2lo + dx;
+
+    double p;
+    if (Precise) {
+        p = 1.0 / 6227020800.0;                 // 1/13!
+        p = p * r + 1.0 / 479001600.0;
+    } else {
+        p = 1.0 / 479001600.0;                  // 1/12!
+    }
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    // 1 + r exactly as hi + lo, so that only the final addition rounds
+    double hi = 1.0 + r;
+    double e = hi + (((1.0 - hi) + r) + r * r * p);
+
+    // 2ⁿ as 2^(n/2)·2^(n - n/2), each factor normal for n ∈ [-1075, 1024]. The clamped arguments give n = 1024
+    // (overflow to ∞) and n = -1075 (underflow to 0) by themselves, and NaN propagates through r, so no
+    // special-case selects are needed; those would let the compiler branch on them and stop the vectorizer.
+    int64_t n1 = ni >> 1, n2 = ni - n1;
+    return e * fromBits(static_cast<uint64_t>(n1 + 1023) << 52) * fromBits(static_cast<uint64_t>(n2 + 1023) << 52);
+}
+
+// log(x); Precise sums R(z) to z¹⁰, otherwise to z⁹
+template <bool Precise>
+inline double logCore(double x) {
+    const double ln2hi = 6.93147180369123816490e-01, ln2lo = 1.90821492927058770002e-10;
+    bool subnormal = x < 0x1p-1022;
+    double xs = blend(subnormal, x * 0x1p54, x);
+    uint64_t bits = toBits(xs);
+    int64_t e = static_cast<int64_t>(bits >> 52) - 1023 - (subnormal ? 54 : 0);
+    double m = fromBits((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+    bool high = m > M_SQRT2;
+    m = blend(high, 0.5 * m, m);
+    e += high;
+    double k = integerToDouble(e);
+
+    double f = m - 1;
+    double s = f / (2.0 + f);
+    double z = s * s;
+    // R(z) = Σ 2zʲ/(2j + 1)
+    double R = Precise ? 2.0 / 21 : 2.0 / 19;
+    if (Precise) R = R * z + 2.0 / 19;
+    R = R * z + 2.0 / 17;
+    R = R * z + 2.0 / 15;
+    R = R * z + 2.0 / 13;
+    R = R * z + 2.0 / 11;
+    R = R * z + 2.0 / 9;
+    R = R * z + 2.0 / 7;
+    R = R * z + 2.0 / 5;
+    R = R * z + 2.0 / 3;
+    R *= z;
+    double hfsq = 0.5 * f * f;
+    double y = k * ln2hi + (f - (hfsq - (s * (hfsq + R) + k * ln2lo)));
+
+    y = blend(x == INFINITY, INFINITY, y);
+    y = blend(x == 0, -INFINITY, y);
+    return blend((x < 0) | (x != x), NAN, y);
+}
+
+// sin(r + δ) and cos(r + δ) for |r| ≤ π/4 and a tiny correction δ; Precise: degrees 17 and 18, otherwise 15 and 16
+template <bool Precise>
+inline void sinCosPolynomial(double r, double delta, double& s, double& c) {
+    double z = r * r;
+    double ps = Precise ? 1.0 / 355687428096000.0 : -1.0 / 1307674368000.0;   // 1/17!, -1/15!
+    if (Precise) ps = ps * z - 1.0 / 1307674368000.0;
+    ps = ps * z + 1.0 / 6227020800.0;
+    ps = ps * z - 1.0 / 39916800.0;
+    ps = ps * z + 1.0 / 362880.0;
+    ps = ps * z - 1.0 / 5040.0;
+    ps = ps * z + 1.0 / 120.0;
+    ps = ps * z - 1.0 / 6.0;
+    // sin(r + δ) ≈ sin r + δ·cos r, with cos r ≈ 1 - z/2 more than accurate enough for δ
+    s = r + (r * z * ps + delta * (1.0 - 0.5 * z));
+
+    double pc = Precise ? 1.0 / 6402373705728000.0 : -1.0 / 20922789888000.0;  // 1/18!, -1/16!
+    if (Precise) pc = pc * z - 1.0 / 20922789888000.0;
+    pc = pc * z + 1.0 / 87178291200.0;
+    pc = pc * z - 1.0 / 479001600.0;
+    pc = pc * z + 1.0 / 3628800.0;
+    pc = pc * z - 1.0 / 40320.0;
+    pc = pc * z + 1.0 / 720.0;
+    pc = pc * z - 1.0 / 24.0;
+    // cos r = w + ((1 - w) - z/2 + z²·P), w = 1 - z/2 (fdlibm), which keeps the rounding of 1 - z/2 exact;
+    // cos(r + δ) ≈ cos r - δ·r
+    double hz = 0.5 * z;
+    double w = 1.0 - hz;
+    c = w + ((((1.0 - w) - hz) - z * z * pc) - delta * r);
+}
+
+const double reductionLimit = 0x1p19;
+
+template <bool Precise>
+inline void sinCosCore(double x, double& sinX, double& cosX) {
+    const double twoOverPi = 6.36619772367581382433e-01;
+    const double pio2_1 = 1.57079632673412561417e+00, pio2_2 = 6.07710050630396597660e-11,
+                 pio2_3 = 2.02226624871116645580e-21, pio2_3t = 8.47842766036889956997e-32;  // fdlibm parts of π/2
+    const double magic = 0x1.8p52;
+    double t = x * twoOverPi + magic;
+    double q = t - magic;
+    int64_t qi = static_cast<int64_t>(toBits(t) - toBits(magic));
+    // Staged as in fdlibm: pio2_1, pio2_2 and pio2_3 have 33 significant bits and |q| < 2²⁰, so every q·pio2_k
+    // is exact, and so is x - q·pio2_1. Each further part is subtracted with a two-sum, so near a multiple of π/2,
+    // where the leading bits cancel, r + δ still carries the reduced argument to far below its own ulp.
+    double a = x - q * pio2_1;
+    double r1, e1, r2, e2, r, delta;
+    twoSum(a, -(q * pio2_2), r1, e1);
+    twoSum(r1, -(q * pio2_3), r2, e2);
+    twoSum(r2, (e1 + e2) - q * pio2_3t, r, delta);
+    // The 4 ulp tier drops δ, which is below half an ulp of r
+    double s, c;
+    sinCosPolynomial<Precise>(r, Precise ? delta : 0.0, s, c);
+    bool swapped = qi & 1;
+    double sv = blend(swapped, c, s), cv = blend(swapped, s, c);
+    sinX = blend(qi & 2, -sv, sv);
+    cosX = blend((qi + 1) & 2, -cv, cv);
+}
+
+// log x as hi + lo with a relative error near 2⁻⁶⁴, for pow. x = 2ᵏ·z with z ∈ [0.6875, 1.375) (the offset
+// trick of glibc's log), so z near 1 never cancels against k·ln 2. The 128 bins of z each store cᵢ⁻¹ with 9
+// significant bits and -log cᵢ⁻¹ in two parts; the bins on either side of 1 use c = 1, where log z needs no table.
+class LogTable {
+public:
+    static const int size = 128;
+    static const uint64_t offset = 0x3FE6000000000000ull;  // bit pattern of 0.6875
+    double inverse[size];
+    double logHi[size], logLo[size];
+
+    LogTable() {
+        for (int i = 0; i < size; i++) {
+            double centre = fromBits(offset + (static_cast<uint64_t>(i) << 45) + (1ull << 44));
+            inverse[i] = (i == 79 || i == 80) ? 1.0 : nearbyint(512.0 / centre) / 512.0;
+            long double lc = -log1pl(static_cast<long double>(inverse[i]) - 1);
+            logHi[i] = static_cast<double>(lc);
+            logLo[i] = static_cast<double>(lc - logHi[i]);
+        }
+    }
+};
+
+const LogTable logTable;
+
+inline void logDoubleDouble(double x, double& hi, double& lo) {
+    const double ln2hi = 6.93147180369123816490e-01, ln2lo = 1.90821492927058770002e-10;
+    uint64_t bits = toBits(x);
+    uint64_t tmp = bits - LogTable::offset;
+    uint64_t i = (tmp >> 45) & (LogTable::size - 1);
+    double k = integerToDouble(static_cast<int64_t>(((tmp >> 52) ^ 0x800) - 0x800));  // signed exponent field
+    double z = fromBits(bits - (tmp & (0xFFFull << 52)));
+    double inv = logTable.inverse[i];
+
+    // r = z·cᵢ⁻¹ - 1 = rHi + rLo exactly, |r| < 2⁻⁷. cᵢ⁻¹ has 9 significant bits, so with z split into 26 + 27
+    // bits both partial products are exact, and so is zh·cᵢ⁻¹ - 1 (whether or not it is fused into an FMA).
+    double zh = fromBits(toBits(z) & 0xFFFFFFFFF8000000ull), zl = z - zh;
+    double rHi, rLo;
+    twoSum(zh * inv - 1.0, zl * inv, rHi, rLo);
+    // log(1 + r) = r - r²/2 + r³·P(r), with r² split exactly so the largest correction carries no rounding
+    double r2, r2Lo;
+    twoProduct(rHi, rHi, r2, r2Lo);
+    double poly = -1.0 / 10;
+    poly = poly * rHi + 1.0 / 9;
+    poly = poly * rHi - 1.0 / 8;
+    poly = poly * rHi + 1.0 / 7;
+    poly = poly * rHi - 1.0 / 6;
+    poly = poly * rHi + 1.0 / 5;
+    poly = poly * rHi - 1.0 / 4;
+    poly = poly * rHi + 1.0 / 3;
+    poly *= rHi * r2;
+
+    // k·ln2hi (exact) + log cᵢ⁻¹ + rHi - r²/2 with two-sums; the small terms go to lo
+    double s1, e1, s2, e2, s3, e3;
+    twoSum(k * ln2hi, logTable.logHi[i], s1, e1);
+    twoSum(s1, rHi, s2, e2);
+    twoSum(s2, -0.5 * r2, s3, e3);
+    lo = e1 + e2 + e3 + (rLo * (1.0 - rHi) - 0.5 * r2Lo + poly + k * ln2lo + logTable.logLo[i]);
+    hi = s3 + lo;
+    lo -= hi - s3;
+}
+
+template <bool Precise>
+inline double powCore(double x, double y) {
+    double hi, lo;
+    logDoubleDouble(x, hi, lo);
+    double p, e;
+    twoProduct(y, hi, p, e);
+    return expCore<Precise>(p, e + y * lo);
+}
+
+inline bool powNeedsLibm(double x, double y) {
+    return !((x > 0x1p-1022) & (x < INFINITY) & (abs(y) < INFINITY));
+}
+
+// Batch kernels: one clone per instruction set, selected at load time. The pow kernels gather from logTable;
+// __restrict on the output tells the compiler that the stores cannot modify the table (SSE2 has no gather, so
+// the default clone of pow stays scalar).
+VECTOR_DISPATCH void expBatchUlp1(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = expCore<true>(x[i]);
+}
+VECTOR_DISPATCH void expBatchUlp4(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = expCore<false>(x[i]);
+}
+VECTOR_DISPATCH void logBatchUlp1(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = logCore<true>(x[i]);
+}
+VECTOR_DISPATCH void logBatchUlp4(const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = logCore<false>(x[i]);
+}
+VECTOR_DISPATCH void sinCosBatchUlp1(const double* x, double* s, double* c, size_t n) {
+    for (size_t i = 0; i < n; i++) sinCosCore<true>(x[i], s[i], c[i]);
+}
+VECTOR_DISPATCH void sinCosBatchUlp4(const double* x, double* s, double* c, size_t n) {
+    for (size_t i = 0; i < n; i++) sinCosCore<false>(x[i], s[i], c[i]);
+}
+VECTOR_DISPATCH void sinBatchUlp1(const double* x, double* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double c;
+        sinCosCore<true>(x[i], s[i], c);
+    }
+}
+VECTOR_DISPATCH void sinBatchUlp4(const double* x, double* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double c;
+        sinCosCore<false>(x[i], s[i], c);
+    }
+}
+VECTOR_DISPATCH void cosBatchUlp1(const double* x, double* c, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s;
+        sinCosCore<true>(x[i], s, c[i]);
+    }
+}
+VECTOR_DISPATCH void cosBatchUlp4(const double* x, double* c, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s;
+        sinCosCore<false>(x[i], s, c[i]);
+    }
+}
+VECTOR_DISPATCH void powBatchUlp1(const double* x, const double* y, double* __restrict z, size_t n) {
+    for (size_t i = 0; i < n; i++) z[i] = powCore<true>(x[i], y[i]);
+}
+VECTOR_DISPATCH void powBatchUlp4(const double* x, const double* y, double* __restrict z, size_t n) {
+    for (size_t i = 0; i < n; i++) z[i] = powCore<false>(x[i], y[i]);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+// The SSE2 clone lacks 64-bit integer compares and shifts and is slower than libm, so without AVX2 the public
+// functions call libm directly
+bool detectVectorUnit() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+const bool vectorUnit = detectVectorUnit();
+
+string activeInstructionSet() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    if (__builtin_cpu_supports("avx512f")) return "AVX-512";
+    if (__builtin_cpu_supports("avx2")) return "AVX2";
+#endif
+    return "scalar libm";
+}
+
+// Public interface: y[i] = f(x[i]) for i < n. In-place calls (y == x) are allowed.
+void vexp(const double* x, double* y, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) y[i] = exp(x[i]);
+        return;
+    }
+    if (accuracy == Accuracy::Ulp1) expBatchUlp1(x, y, n);
+    else expBatchUlp4(x, y, n);
+}
+
+void vlog(const double* x, double* y, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) y[i] = log(x[i]);
+        return;
+    }
+    if (accuracy == Accuracy::Ulp1) logBatchUlp1(x, y, n);
+    else logBatchUlp4(x, y, n);
+}
+
+void vsin(const double* x, double* y, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) y[i] = sin(x[i]);
+        return;
+    }
+    // Inputs beyond the reduction range are patched afterwards, so read them before an in-place call overwrites them
+    vector<pair<size_t, double>> large;
+    for (size_t i = 0; i < n; i++) {
+        if (!(abs(x[i]) < reductionLimit) && x[i] == x[i]) large.push_back({i, x[i]});
+    }
+    if (accuracy == Accuracy::Ulp1) sinBatchUlp1(x, y, n);
+    else sinBatchUlp4(x, y, n);
+    for (auto& item : large) y[item.first] = sin(item.second);
+}
+
+void vcos(const double* x, double* y, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) y[i] = cos(x[i]);
+        return;
+    }
+    vector<pair<size_t, double>> large;
+    for (size_t i = 0; i < n; i++) {
+        if (!(abs(x[i]) < reductionLimit) && x[i] == x[i]) large.push_back({i, x[i]});
+    }
+    if (accuracy == Accuracy::Ulp1) cosBatchUlp1(x, y, n);
+    else cosBatchUlp4(x, y, n);
+    for (auto& item : large) y[item.first] = cos(item.second);
+}
+
+void vsincos(const double* x, double* s, double* c, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) {
+            double xi = x[i];
+            s[i] = sin(xi);
+            c[i] = cos(xi);
+        }
+        return;
+    }
+    vector<pair<size_t, double>> large;
+    for (size_t i = 0; i < n; i++) {
+        if (!(abs(x[i]) < reductionLimit) && x[i] == x[i]) large.push_back({i, x[i]});
+    }
+    if (accuracy == Accuracy::Ulp1) sinCosBatchUlp1(x, s, c, n);
+    else sinCosBatchUlp4(x, s, c, n);
+    for (auto& item : large) {
+        s[item.first] = sin(item.second);
+        c[item.first] = cos(item.second);
+    }
+}
+
+void vpow(const double* x, const double* y, double* z, size_t n, Accuracy accuracy = Accuracy::Ulp1) {
+    if (!vectorUnit) {
+        for (size_t i = 0; i < n; i++) z[i] = pow(x[i], y[i]);
+        return;
+    }
+    vector<pair<size_t, pair<double, double>>> special;
+    for (size_t i = 0; i < n; i++) {
+        if (powNeedsLibm(x[i], y[i])) special.push_back({i, {x[i], y[i]}});
+    }
+    // The kernels take a non-aliased output; an in-place call goes through a buffer
+    vector<double> buffer;
+    double* out = z;
+    if (z == x || z == y) {
+        buffer.resize(n);
+        out = buffer.data();
+    }
+    if (accuracy == Accuracy::Ulp1) powBatchUlp1(x, y, out, n);
+    else powBatchUlp4(x, y, out, n);
+    if (out != z) copy(buffer.begin(), buffer.end(), z);
+    for (auto& item : special) z[item.first] = pow(item.second.first, item.second.second);
+}
+
+
+// Error of a double result in units of the last place of the correctly rounded long double reference
+double ulpError(double value, long double reference) {
+    double rounded = static_cast<double>(reference);
+    if (isinf(rounded) || rounded == 0) return value == rounded ? 0 : INFINITY;
+    double ulp = nextafter(abs(rounded), INFINITY) - abs(rounded);
+    return static_cast<double>(fabsl(static_cast<long double>(value) - reference) / ulp);
+}
+
+uint64_t lcgState = 0x2545F4914F6CDD1Dull;
+double uniformRandom(double a, double b) {
+    lcgState = lcgState * 6364136223846793005ull + 1442695040888963407ull;
+    return a + (b - a) * ((lcgState >> 11) * 0x1.0p-53);
+}
+
+template <typename F>
+double timePerElement(F body, size_t n, int repeats) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) body();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count() / (static_cast<double>(n) * repeats) * 1e9;
+}
+
+int main() {
+    cout << "=== VECTORIZED ELEMENTARY FUNCTIONS ===" << endl;
+    cout << "Runtime dispatch selected: " << activeInstructionSet() << endl;
+
+    const size_t n = 1 << 20;
+    vector<double> x(n), y(n), out(n), out2(n), libm(n);
+
+    // Accuracy: maximum error in ulp against long double libm
+    cout << "\n=== ACCURACY (max ulp over 2^20 random arguments, vs long double reference) ===" << endl;
+    cout << setw(8) << "function" << setw(30) << "range" << setw(12) << "Ulp1 tier" << setw(12) << "Ulp4 tier"
+         << setw(12) << "libm" << endl;
+    cout << string(74, '-') << endl;
+    struct Case {
+        string name, range;
+        double a, b;
+    };
+    for (const Case& c : vector<Case>{{"exp", "[-700, 700]", -700, 700}, {"exp", "[-1, 1]", -1, 1},
+                                      {"log", "[1e-300, 1e300]", -690, 690}, {"log", "[0.5, 2]", 0.5, 2},
+                                      {"sin", "[-100, 100]", -100, 100}, {"cos", "[-100, 100]", -100, 100},
+                                      {"pow", "x∈[0.01,100], |y·ln x|<700", 0.01, 100}}) {
+        for (size_t i = 0; i < n; i++) {
+            x[i] = uniformRandom(c.a, c.b);
+            if (c.name == "log" && c.a < 0) x[i] = exp(x[i]);   // log-uniform over 1e-300..1e300
+            if (c.name == "pow") y[i] = uniformRandom(-700, 700) / max(1e-3, abs(log(x[i])));
+        }
+        double worst[3] = {0, 0, 0};
+        for (int tier = 0; tier < 3; tier++) {
+            Accuracy accuracy = tier == 0 ? Accuracy::Ulp1 : Accuracy::Ulp4;
+            if (c.name == "exp") {
+                if (tier < 2) vexp(x.data(), out.data(), n, accuracy);
+                else for (size_t i = 0; i < n; i++) out[i] = exp(x[i]);
+            } else if (c.name == "log") {
+                if (tier < 2) vlog(x.data(), out.data(), n, accuracy);
+                else for (size_t i = 0; i < n; i++) out[i] = log(x[i]);
+            } else if (c.name == "sin") {
+                if (tier < 2) vsin(x.data(), out.data(), n, accuracy);
+                else for (size_t i = 0; i < n; i++) out[i] = sin(x[i]);
+            } else if (c.name == "cos") {
+                if (tier < 2) vcos(x.data(), out.data(), n, accuracy);
+                else for (size_t i = 0; i < n; i++) out[i] = cos(x[i]);
+            } else {
+                if (tier < 2) vpow(x.data(), y.data(), out.data(), n, accuracy);
+                else for (size_t i = 0; i < n; i++) out[i] = pow(x[i], y[i]);
+            }
+            for (size_t i = 0; i < n; i++) {
+                long double ref;
+                long double xl = x[i];
+                if (c.name == "exp") ref = expl(xl);
+                else if (c.name == "log") ref = logl(xl);
+                else if (c.name == "sin") ref = sinl(xl);
+                else if (c.name == "cos") ref = cosl(xl);
+                else ref = powl(xl, static_cast<long double>(y[i]));
+                worst[tier] = max(worst[tier], ulpError(out[i], ref));
+            }
+        }
+        cout << setw(8) << c.name << setw(30) << c.range << fixed << setprecision(3) << setw(12) << worst[0]
+             << setw(12) << worst[1] << setw(12) << worst[2] << endl;
+    }
+
+    // Arguments next to the zeros of sin and cos, where the reduction cancels the leading bits: x = fl(k·π/2)
+    // up to the reduction limit 2¹⁹
+    {
+        size_t count = static_cast<size_t>(reductionLimit / M_PI_2);
+        vector<double> xk(count), sk(count), ck(count);
+        for (size_t k = 0; k < count; k++) xk[k] = k * M_PI_2;
+        double worst[3] = {0, 0, 0};
+        for (int tier = 0; tier < 3; tier++) {
+            if (tier < 2) vsincos(xk.data(), sk.data(), ck.data(), count, tier == 0 ? Accuracy::Ulp1 : Accuracy::Ulp4);
+            else for (size_t k = 0; k < count; k++) sk[k] = sin(xk[k]), ck[k] = cos(xk[k]);
+            for (size_t k = 0; k < count; k++) {
+                long double xl = xk[k];
+                worst[tier] = max({worst[tier], ulpError(sk[k], sinl(xl)), ulpError(ck[k], cosl(xl))});
+            }
+        }
+        cout << setw(8) << "sincos" << setw(30) << "x = fl(k·π/2), k < " + to_string(count) << fixed << setprecision(3)
+             << setw(12) << worst[0] << setw(12) << worst[1] << setw(12) << worst[2] << endl;
+    }
+
+    // Special values
+    vector<double> specials = {0.0, -0.0, 1.0, -1.0, 1e-310, 710.0, -746.0, INFINITY, -INFINITY, NAN};
+    vector<double> se(specials.size()), sl(specials.size());
+    vexp(specials.data(), se.data(), specials.size());
+    vlog(specials.data(), sl.data(), specials.size());
+    cout << "\nSpecial values (vexp / libm exp, vlog / libm log):" << endl;
+    for (size_t i = 0; i < specials.size(); i++) {
+        cout << "  x = " << setw(9) << defaultfloat << specials[i] << ":  " << setw(13) << se[i] << " / " << setw(13)
+             << exp(specials[i]) << "    " << setw(13) << sl[i] << " / " << setw(13) << log(specials[i]) << endl;
+    }
+
+    // Throughput
+    cout << "\n=== THROUGHPUT (ns per element, 2^20 elements) ===" << endl;
+    cout << setw(10) << "function" << setw(12) << "libm" << setw(12) << "Ulp1" << setw(12) << "Ulp4" << setw(10)
+         << "speedup" << endl;
+    cout << string(56, '-') << endl;
+    for (size_t i = 0; i < n; i++) {
+        x[i] = uniformRandom(-50, 50);
+        y[i] = uniformRandom(0.1, 3);
+    }
+    volatile double sink = 0;
+    auto row = [&](const string& name, double libmTime, double t1, double t4) {
+        cout << setw(10) << name << fixed << setprecision(2) << setw(12) << libmTime << setw(12) << t1 << setw(12)
+             << t4 << setw(9) << setprecision(1) << libmTime / t1 << "x" << endl;
+    };
+    const int repeats = 10;
+    row("exp",
+        timePerElement([&]() { for (size_t i = 0; i < n; i++) out[i] = exp(x[i]); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vexp(x.data(), out.data(), n, Accuracy::Ulp1); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vexp(x.data(), out.data(), n, Accuracy::Ulp4); sink = sink + out[7]; }, n, repeats));
+    row("log",
+        timePerElement([&]() { for (size_t i = 0; i < n; i++) out[i] = log(y[i]); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vlog(y.data(), out.data(), n, Accuracy::Ulp1); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vlog(y.data(), out.data(), n, Accuracy::Ulp4); sink = sink + out[7]; }, n, repeats));
+    row("sin",
+        timePerElement([&]() { for (size_t i = 0; i < n; i++) out[i] = sin(x[i]); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vsin(x.data(), out.data(), n, Accuracy::Ulp1); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vsin(x.data(), out.data(), n, Accuracy::Ulp4); sink = sink + out[7]; }, n, repeats));
+    row("sincos",
+        timePerElement([&]() {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = sin(x[i]);
+                out2[i] = cos(x[i]);
+            }
+            sink = sink + out[7];
+        }, n, repeats),
+        timePerElement([&]() { vsincos(x.data(), out.data(), out2.data(), n, Accuracy::Ulp1); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vsincos(x.data(), out.data(), out2.data(), n, Accuracy::Ulp4); sink = sink + out[7]; }, n, repeats));
+    row("pow",
+        timePerElement([&]() { for (size_t i = 0; i < n; i++) out[i] = pow(y[i], x[i]); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vpow(y.data(), x.data(), out.data(), n, Accuracy::Ulp1); sink = sink + out[7]; }, n, repeats),
+        timePerElement([&]() { vpow(y.data(), x.data(), out.data(), n, Accuracy::Ulp4); sink = sink + out[7]; }, n, repeats));
+
+    // The hot paths named in the other files, evaluated over a batch of points
+    cout << "\n=== BATCH INTEGRANDS FROM THE OTHER PROGRAMS ===" << endl;
+    for (size_t i = 0; i < n; i++) x[i] = 2.0 * i / n;   // grid on [0, 2)
+    double scalarTime = timePerElement([&]() {
+        for (size_t i = 0; i < n; i++) out[i] = -x[i]*x[i] - 2*x[i] - 2 + 3*exp(x[i]);
+        sink = sink + out[7];
+    }, n, repeats);
+    double vectorTime = timePerElement([&]() {
+        vexp(x.data(), out2.data(), n);
+        for (size_t i = 0; i < n; i++) out2[i] = -x[i]*x[i] - 2*x[i] - 2 + 3*out2[i];
+        sink = sink + out2[7];
+    }, n, repeats);
+    double maxDiff = 0;
+    for (size_t i = 0; i < n; i++) maxDiff = max(maxDiff, abs(out[i] - out2[i]) / abs(out[i]));
+    cout << "exactSolution (11.cpp), -x² - 2x - 2 + 3eˣ: " << fixed << setprecision(2) << scalarTime << " -> "
+         << vectorTime << " ns/point, max relative difference " << scientific << setprecision(1) << maxDiff << endl;
+
+    scalarTime = timePerElement([&]() {
+        for (size_t i = 0; i < n; i++) out[i] = exp(x[i]) - 2*x[i];
+        sink = sink + out[7];
+    }, n, repeats);
+    vectorTime = timePerElement([&]() {
+        vexp(x.data(), out2.data(), n);
+        for (size_t i = 0; i < n; i++) out2[i] -= 2*x[i];
+        sink = sink + out2[7];
+    }, n, repeats);
+    cout << "f(x) = eˣ - 2x (8.cpp):                     " << fixed << setprecision(2) << scalarTime << " -> "
+         << vectorTime << " ns/point" << endl;
+
+    // Buffon: crossing test x ≤ (l/2) sin θ with θ ∈ [0, π/2)
+    for (size_t i = 0; i < n; i++) {
+        x[i] = uniformRandom(0, 0.5);
+        y[i] = uniformRandom(0, M_PI / 2);
+    }
+    long long crossScalar = 0, crossVector = 0;
+    scalarTime = timePerElement([&]() {
+        crossScalar = 0;
+        for (size_t i = 0; i < n; i++) crossScalar += x[i] <= 0.5 * sin(y[i]);
+    }, n, repeats);
+    vectorTime = timePerElement([&]() {
+        vsin(y.data(), out.data(), n, Accuracy::Ulp4);
+        crossVector = 0;
+        for (size_t i = 0; i < n; i++) crossVector += x[i] <= 0.5 * out[i];
+    }, n, repeats);
+    cout << "Buffon crossing test (14.cpp), sin θ:       " << scalarTime << " -> " << vectorTime
+         << " ns/trial, crossings " << crossScalar << " vs " << crossVector << endl;
+
+    return 0;
+}
@@ -0,0 +1,793 @@
+/*Big-Integer Factorial (Prime Swing, Product Trees, NTT Multiplication) and log n!
+factorialIterative in 4BasicProgrammingProblems.cpp returns long long and silently wraps from 21! on. The recursive
+version also nests n calls deep. This file computes n! exactly as a BigInt (base 2³² limbs) with no recursion
+deeper than log n.
+
+Multiplication picks its algorithm by operand size (the shorter operand, in 32-bit limbs):
+- < 32 limbs:     schoolbook, O(n·m)
+- < 512 limbs:    Karatsuba, a·b = z2·B²ᵐ + ((a0 + a1)(b0 + b1) - z0 - z2)·Bᵐ + z0, O(n^1.585)
+- otherwise:      number-theoretic transform (NTT), O(n log n). The limbs are convolved modulo three primes
+                  p = c·2ᵏ + 1 < 2³⁰, using Montgomery arithmetic. The exact coefficients (< min(n, m)·2⁶⁴ < p₀p₁p₂ ≈ 2⁸⁶)
+                  are then recovered by Garner's CRT. The three primes are independent, so each can run on its
+                  own thread. Below 2¹³ points the transform runs stage by stage inside the cache. Above that it
+                  recurses on the halves. A much shorter operand is multiplied slice by slice against the longer one,
+                  and its transform is computed once.
+
+Factorial algorithms:
+- naive:            r = r·k for k = 2..n, O(n²) limb operations
+- binary splitting: a balanced product tree over 2..n. Small factors are packed into 32-bit words, and the two
+                    halves of each node run on separate threads while threads remain.
+- prime swing (Luschny): n! = 2^(n - popcount n) · o(n), with o(n) = o(⌊n/2⌋)² · swing(n) the odd part, where
+                    swing(n) = n!/⌊n/2⌋!² = ∏ p^eₚ, and eₚ = Σₖ ⌊n/pᵏ⌋ mod 2. Every prime power p^eₚ is ≤ n, so the
+                    factors fit in 32 bits. The costly work is log n squarings plus one product tree over the primes,
+                    instead of n multiplications.
+
+log n! and lgamma: log n! comes from a table for n < 1024 and from the Stirling series above
+  ln Γ(x) = (x - ½)ln x - x + ½ln 2π + 1/(12x) - 1/(360x³) + 1/(1260x⁵) - 1/(1680x⁷) + 1/(1188x⁹) - 691/(360360x¹¹).
+For real x, Γ(x) is shifted up to x ≥ 10 (Γ(x+1) = xΓ(x)), and the reflection formula handles x < ½.
+The digit count of n! is ⌊log₁₀ n!⌋ + 1. Binomial terms are not formed as log n! - log k! - log (n-k)!: for
+n = 10⁸ each term is near 10⁹ and the difference keeps only 7 digits. Loader's saddle-point form subtracts
+only the small Stirling remainders δ(m) = log m! - (m + ½)ln m + m - ½ln 2π and the deviance
+bd0(x, μ) = x ln(x/μ) + μ - x (a series when x ≈ μ):
+  log P(X = k) = δ(n) - δ(k) - δ(n-k) - bd0(k, np) - bd0(n-k, nq) - ½ln(2πk(n-k)/n),
+and log C(n, k) is the same with p = k/n plus k ln(n/k) + (n-k) ln(n/(n-k)), all positive terms.
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+// Butterfly loops are cloned for AVX-512 and AVX2 and picked at load time (as in 29VectorMath.cpp)
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VECTOR_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VECTOR_DISPATCH
+#endif
+
+// One NTT prime p = c·2ᵏ + 1 with Montgomery arithmetic (R = 2³²); residues are kept in [0, p)
+struct NttPrime {
+    uint32_t p;
+    uint32_t negInv;   // -p⁻¹ mod 2³²
+    uint32_t r2;       // 2⁶⁴ mod p, converts into Montgomery form
+    uint32_t generator;
+    static const size_t cacheBlock = 1 << 13;   // 32 KB of residues
+
+    NttPrime(uint32_t prime, uint32_t g) {
+        p = prime;
+        generator = g;
+        uint32_t inv = p;                              // p·p ≡ 1 mod 8, Newton doubles the correct bits
+        for (int i = 0; i < 4; i++) inv *= 2 - p * inv;
+        negInv = -inv;
+        r2 = static_cast<uint32_t>((static_cast<unsigned __int128>(1) << 64) % p);
+    }
+
+    uint32_t reduce(uint64_t t) const {
+        uint32_t m = static_cast<uint32_t>(t) * negInv;
+        uint32_t u = static_cast<uint32_t>((t + static_cast<uint64_t>(m) * p) >> 32);
+        return min(u, u - p);   // u - p wraps when u < p; branch-free, so the butterflies stay predictable
+    }
+    uint32_t mul(uint32_t a, uint32_t b) const { return reduce(static_cast<uint64_t>(a) * b); }
+    uint32_t add(uint32_t a, uint32_t b) const { uint32_t s = a + b; return min(s, s - p); }
+    uint32_t sub(uint32_t a, uint32_t b) const { uint32_t d = a - b; return min(d, d + p); }
+    uint32_t toMontgomery(uint32_t a) const { return mul(a, r2); }
+
+    // base and result in Montgomery form
+    uint32_t power(uint32_t base, uint64_t e) const {
+        uint32_t result = toMontgomery(1);
+        for (; e; e >>= 1, base = mul(base, base))
+            if (e & 1) result = mul(result, base);
+        return result;
+    }
+
+    // rt[len + j] = w^j for the primitive 2·len-th root w (Montgomery form), len = 1, 2, 4, ..., n/2.
+    // Only the top level is computed; level len is every other entry of level 2·len.
+    vector<uint32_t> rootTable(size_t n) const {
+        vector<uint32_t> rt(max<size_t>(n, 2));
+        size_t half = max<size_t>(n / 2, 1);
+        uint32_t w = power(toMontgomery(generator), (p - 1) / (2 * half));
+        rt[half] = toMontgomery(1);
+        for (size_t j = 1; j < half; j++) rt[half + j] = mul(rt[half + j - 1], w);
+        for (size_t len = half / 2; len >= 1; len >>= 1)
+            for (size_t j = 0; j < len; j++) rt[len + j] = rt[2 * len + 2 * j];
+        return rt;
+    }
+
+    // Decimation in frequency: natural order in, bit-reversed order out. After the first stage the two halves
+    // are independent, so recursing on them keeps all later stages of a block in cache.
+    void forward(uint32_t* a, size_t n, const vector<uint32_t>& rt) const {
+        if (n <= cacheBlock) {
+            forwardBlock(a, n, rt.data());
+            return;
+        }
+        forwardStage(a, n / 2, rt.data());
+        forward(a, n / 2, rt);
+        forward(a + n / 2, n / 2, rt);
+    }
+
+    // Decimation in time: bit-reversed order in, natural order out (unscaled)
+    void inverse(uint32_t* a, size_t n, const vector<uint32_t>& rt) const {
+        if (n <= cacheBlock) {
+            inverseBlock(a, n, rt.data());
+            return;
+        }
+        inverse(a, n / 2, rt);
+        inverse(a + n / 2, n / 2, rt);
+        inverseStage(a, n / 2, rt.data());
+    }
+
+    // The dispatched entry points cover whole stages or blocks, so the per-call dispatch cost stays negligible
+    VECTOR_DISPATCH void forwardStage(uint32_t* a, size_t len, const uint32_t* rt) const { butterflyForward(a, len, rt); }
+    VECTOR_DISPATCH void inverseStage(uint32_t* a, size_t len, const uint32_t* rt) const { butterflyInverse(a, len, rt); }
+
+    VECTOR_DISPATCH void forwardBlock(uint32_t* a, size_t n, const uint32_t* rt) const {
+        for (size_t len = n / 2; len >= 1; len >>= 1)
+            for (size_t i = 0; i < n; i += 2 * len) butterflyForward(a + i, len, rt);
+    }
+
+    VECTOR_DISPATCH void inverseBlock(uint32_t* a, size_t n, const uint32_t* rt) const {
+        for (size_t len = 1; len < n; len <<= 1)
+            for (size_t i = 0; i < n; i += 2 * len) butterflyInverse(a + i, len, rt);
+    }
+
+    void butterflyForward(uint32_t* a, size_t len, const uint32_t* rt) const {
+        const uint32_t* w = rt + len;
+        for (size_t j = 0; j < len; j++) {
+            uint32_t u = a[j], v = a[j + len];
+            a[j] = add(u, v);
+            a[j + len] = mul(sub(u, v), w[j]);
+        }
+    }
+
+    // w⁻ʲ = -w^(len - j) for the 2·len-th root, so the forward table serves the inverse transform too
+    void butterflyInverse(uint32_t* a, size_t len, const uint32_t* rt) const {
+        const uint32_t* w = rt + len;
+        uint32_t u = a[0], v = a[len];
+        a[0] = add(u, v);
+        a[len] = sub(u, v);
+        for (size_t j = 1; j < len; j++) {
+            u = a[j];
+            v = mul(a[j + len], w[len - j]);
+            a[j] = sub(u, v);
+            a[j + len] = add(u, v);
+        }
+    }
+
+    // Products of b with the slices a[c·slice, (c + 1)·slice) modulo p, each an acyclic convolution in a transform
+    // of length n ≥ slice + nb - 1 (a power of two). Slice c occupies [c·n, (c + 1)·n) of the result. b is
+    // transformed only once; a == b squares with a single slice.
+    vector<uint32_t> convolveSlices(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, size_t n, size_t slice) const {
+        vector<uint32_t> rt = rootTable(n);
+        bool square = (a == b && na == nb);
+        // reduce(x) = x·R⁻¹ mod p brings a full 32-bit limb into [0, p) without a division
+        vector<uint32_t> fb;
+        if (!square) {
+            fb.assign(n, 0);
+            for (size_t i = 0; i < nb; i++) fb[i] = reduce(b[i]);
+            forward(fb.data(), n, rt);
+        }
+        // Inputs carry R⁻¹ each and the pointwise product one more: the final scale is n⁻¹·R³, applied as a Montgomery
+        // product with n⁻¹·R⁴
+        uint32_t nInv = power(toMontgomery(static_cast<uint32_t>(n % p)), p - 2);   // n⁻¹·R
+        uint32_t scale = toMontgomery(toMontgomery(toMontgomery(nInv)));
+
+        size_t slices = (na + slice - 1) / slice;
+        vector<uint32_t> out(slices * n, 0);
+        for (size_t c = 0; c < slices; c++) {
+            uint32_t* fa = out.data() + c * n;
+            size_t len = min(slice, na - c * slice);
+            for (size_t i = 0; i < len; i++) fa[i] = reduce(a[c * slice + i]);
+            forward(fa, n, rt);
+            const uint32_t* other = square ? fa : fb.data();
+            for (size_t i = 0; i < n; i++) fa[i] = mul(fa[i], other[i]);
+            inverse(fa, n, rt);
+            for (size_t i = 0; i < n; i++) fa[i] = mul(fa[i], scale);
+        }
+        return out;
+    }
+};
+
+constexpr uint64_t powMod(uint64_t base, uint64_t e, uint64_t m) {
+    uint64_t result = 1;
+    for (base %= m; e; e >>= 1, base = base * base % m)
+        if (e & 1) result = result * base % m;
+    return result;
+}
+
+class BigInt {
+private:
+    vector<uint32_t> limb;   // little endian, base 2³², no leading zero limbs (zero is empty)
+
+    static const size_t karatsubaThreshold = 32;
+    static const size_t nttThreshold = 512;
+    static const size_t nttMaxLength = size_t(1) << 23;   // largest power of two dividing p₀ - 1
+
+    void trim() {
+        while (!limb.empty() && limb.back() == 0) limb.pop_back();
+    }
+
+    static vector<uint32_t> mulSchool(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+        vector<uint32_t> r(na + nb, 0);
+        for (size_t i = 0; i < na; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < nb; j++) {
+                uint64_t t = static_cast<uint64_t>(a[i]) * b[j] + r[i + j] + carry;
+                r[i + j] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+            r[i + nb] = static_cast<uint32_t>(carry);
+        }
+        return r;
+    }
+
+    static vector<uint32_t> addLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+        if (na < nb) { swap(a, b); swap(na, nb); }
+        vector<uint32_t> r(na + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < na; i++) {
+            carry += static_cast<uint64_t>(a[i]) + (i < nb ? b[i] : 0);
+            r[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        r[na] = static_cast<uint32_t>(carry);
+        return r;
+    }
+
+    // r += x·2^(32·shift); limbs of x past the end of r must be zero
+    static void addShifted(vector<uint32_t>& r, const vector<uint32_t>& x, size_t shift) {
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < x.size() && shift + i < r.size(); i++) {
+            carry += static_cast<uint64_t>(r[shift + i]) + x[i];
+            r[shift + i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        for (i += shift; carry && i < r.size(); i++) {
+            carry += r[i];
+            r[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+    }
+
+    // r -= x, requires r ≥ x
+    static void subtractFrom(vector<uint32_t>& r, const vector<uint32_t>& x) {
+        int64_t borrow = 0;
+        size_t i = 0;
+        for (; i < x.size(); i++) {
+            borrow += static_cast<int64_t>(r[i]) - x[i];
+            r[i] = static_cast<uint32_t>(borrow);
+            borrow >>= 32;   // arithmetic shift: 0 or -1
+        }
+        for (; borrow && i < r.size(); i++) {
+            borrow += r[i];
+            r[i] = static_cast<uint32_t>(borrow);
+            borrow >>= 32;
+        }
+    }
+
+    // Requires na ≥ nb > na/2
+    static vector<uint32_t> karatsuba(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+        size_t m = na / 2;
+        vector<uint32_t> z0 = mulLimbs(a, m, b, m, 1);
+        vector<uint32_t> z2 = mulLimbs(a + m, na - m, b + m, nb - m, 1);
+        vector<uint32_t> sa = addLimbs(a, m, a + m, na - m);
+        vector<uint32_t> sb = addLimbs(b, m, b + m, nb - m);
+        vector<uint32_t> z1 = mulLimbs(sa.data(), sa.size(), sb.data(), sb.size(), 1);
+        subtractFrom(z1, z0);
+        subtractFrom(z1, z2);
+
+        vector<uint32_t> r(na + nb, 0);
+        copy(z0.begin(), z0.end(), r.begin());
+        addShifted(r, z2, 2 * m);
+        addShifted(r, z1, m);
+        return r;
+    }
+
+    // Three-prime NTT product; the primes run on up to three threads. A much shorter b is multiplied slice by slice
+    // against a, reusing its transform.
+    static vector<uint32_t> mulNtt(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, int threads) {
+        static constexpr uint64_t p0 = 998244353, p1 = 167772161, p2 = 469762049;   // 119·2²³ + 1, 5·2²⁵ + 1, 7·2²⁶ + 1
+        static const NttPrime primes[3] = {NttPrime(p0, 3), NttPrime(p1, 3), NttPrime(p2, 3)};
+        bool square = (a == b && na == nb);
+
+        // Slice length minimizing (2·slices + 1)·n·log n over power-of-two n; one slice is the plain product
+        size_t n = 1, slice = na;
+        while (n < na + nb - 1) n <<= 1;
+        if (!square) {
+            double bestCost = 3.0 * n * log2(static_cast<double>(n));
+            for (size_t m = 2; m < n; m <<= 1) {
+                if (m < 2 * nb) continue;
+                size_t s = m - nb + 1;
+                double cost = (2.0 * ((na + s - 1) / s) + 1) * m * log2(static_cast<double>(m));
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    n = m;
+                    slice = s;
+                }
+            }
+        }
+
+        vector<uint32_t> residue[3];
+        auto run = [&](int k) { residue[k] = primes[k].convolveSlices(a, na, b, nb, n, slice); };
+        vector<thread> pool;
+        for (int k = 1; k < 3; k++) {
+            if (k < threads) pool.emplace_back(run, k);
+            else run(k);
+        }
+        run(0);
+        for (auto& t : pool) t.join();
+
+        // Garner: x = r₀ + p₀·t₁ + p₀p₁·t₂ < p₀p₁p₂ (constant moduli, so the % compile to multiplications)
+        constexpr uint64_t inv01 = powMod(p0, p1 - 2, p1);
+        constexpr uint64_t inv012 = powMod(p0 * p1 % p2, p2 - 2, p2);
+        vector<uint32_t> r(na + nb, 0), part;
+        for (size_t c = 0; c * slice < na; c++) {
+            size_t count = min(slice, na - c * slice) + nb;
+            part.assign(count, 0);
+            unsigned __int128 carry = 0;
+            for (size_t i = 0; i + 1 < count; i++) {
+                size_t k = c * n + i;
+                uint64_t r0 = residue[0][k], r1 = residue[1][k], r2 = residue[2][k];
+                uint64_t t1 = (r1 + p1 - r0 % p1) % p1 * inv01 % p1;
+                uint64_t x01 = r0 + p0 * t1;
+                uint64_t t2 = (r2 + p2 - x01 % p2) % p2 * inv012 % p2;
+                carry += x01 + static_cast<unsigned __int128>(p0 * p1) * t2;
+                part[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            part[count - 1] = static_cast<uint32_t>(carry);
+            addShifted(r, part, c * slice);
+        }
+        return r;
+    }
+
+    static vector<uint32_t> mulLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, int threads) {
+        if (na < nb) { swap(a, b); swap(na, nb); }
+        if (nb == 0) return {};
+        if (nb < karatsubaThreshold) return mulSchool(a, na, b, nb);
+        if (nb >= nttThreshold && na + nb <= nttMaxLength) return mulNtt(a, na, b, nb, threads);
+        if (2 * nb <= na) {
+            // Unbalanced: multiply b by nb-limb slices of a
+            vector<uint32_t> r(na + nb, 0);
+            for (size_t offset = 0; offset < na; offset += nb) {
+                size_t len = min(nb, na - offset);
+                addShifted(r, mulLimbs(a + offset, len, b, nb, threads), offset);
+            }
+            return r;
+        }
+        return karatsuba(a, na, b, nb);
+    }
+
+public:
+    BigInt(uint64_t value = 0) {
+        while (value) {
+            limb.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    static BigInt multiply(const BigInt& a, const BigInt& b, int threads = 1) {
+        BigInt r;
+        r.limb = mulLimbs(a.limb.data(), a.limb.size(), b.limb.data(), b.limb.size(), threads);
+        r.trim();
+        return r;
+    }
+
+    static BigInt square(const BigInt& a, int threads = 1) { return multiply(a, a, threads); }
+
+    void mulSmall(uint32_t m) {
+        uint64_t carry = 0;
+        for (auto& x : limb) {
+            carry += static_cast<uint64_t>(x) * m;
+            x = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry) limb.push_back(static_cast<uint32_t>(carry));
+        if (m == 0) limb.clear();
+    }
+
+    void shiftLeft(size_t bits) {
+        if (limb.empty()) return;
+        size_t words = bits / 32, rest = bits % 32;
+        if (rest) {
+            uint32_t carry = 0;
+            for (auto& x : limb) {
+                uint32_t next = x >> (32 - rest);
+                x = (x << rest) | carry;
+                carry = next;
+            }
+            if (carry) limb.push_back(carry);
+        }
+        limb.insert(limb.begin(), words, 0);
+    }
+
+    size_t limbCount() const { return limb.size(); }
+
+    size_t bitLength() const {
+        if (limb.empty()) return 0;
+        return 32 * (limb.size() - 1) + (32 - __builtin_clz(limb.back()));
+    }
+
+    uint32_t mod(uint32_t m) const {
+        uint64_t r = 0;
+        for (size_t i = limb.size(); i-- > 0;) r = ((r << 32) | limb[i]) % m;
+        return static_cast<uint32_t>(r);
+    }
+
+    bool operator==(const BigInt& other) const { return limb == other.limb; }
+
+    // log₁₀ of the value from its top 64 bits (about 12 correct leading digits for numbers of any size)
+    long double log10Value() const {
+        if (limb.empty()) return -INFINITY;
+        size_t bits = bitLength();
+        size_t shift = bits > 64 ? bits - 64 : 0;
+        uint64_t top = 0;
+        for (size_t b = 0; b < 64 && b < bits; b++) {
+            size_t pos = shift + b;
+            if ((limb[pos / 32] >> (pos % 32)) & 1) top |= uint64_t(1) << b;
+        }
+        return log10l(static_cast<long double>(top)) + shift * 0.301029995663981195213738894724493027L;
+    }
+
+    // Repeated division by 10⁹, O(n²); meant for numbers of a few thousand digits
+    string toString() const {
+        if (limb.empty()) return "0";
+        vector<uint32_t> work = limb;
+        vector<uint32_t> chunks;
+        while (!work.empty()) {
+            uint64_t r = 0;
+            for (size_t i = work.size(); i-- > 0;) {
+                uint64_t cur = (r << 32) | work[i];
+                work[i] = static_cast<uint32_t>(cur / 1000000000);
+                r = cur % 1000000000;
+            }
+            chunks.push_back(static_cast<uint32_t>(r));
+            while (!work.empty() && work.back() == 0) work.pop_back();
+        }
+        string s = to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            string part = to_string(chunks[i]);
+            s += string(9 - part.size(), '0') + part;
+        }
+        return s;
+    }
+};
+
+class BigFactorial {
+private:
+    int numThreads;
+    vector<uint32_t> primes;   // odd primes up to sievedTo
+    uint32_t sievedTo = 0;
+
+    void sieve(uint32_t n) {
+        if (n <= sievedTo) return;
+        vector<bool> composite(n + 1, false);
+        primes.clear();
+        for (uint32_t i = 3; i <= n; i += 2) {
+            if (composite[i]) continue;
+            primes.push_back(i);
+            for (uint64_t j = static_cast<uint64_t>(i) * i; j <= n; j += 2 * i) composite[j] = true;
+        }
+        sievedTo = n;
+    }
+
+    // Merges consecutive factors while the product fits in 32 bits
+    static vector<uint32_t> packFactors(const vector<uint32_t>& factors) {
+        vector<uint32_t> words;
+        uint64_t acc = 1;
+        for (uint32_t f : factors) {
+            if (acc * f > 0xFFFFFFFFull) {
+                words.push_back(static_cast<uint32_t>(acc));
+                acc = f;
+            } else {
+                acc *= f;
+            }
+        }
+        if (acc > 1) words.push_back(static_cast<uint32_t>(acc));
+        return words;
+    }
+
+    static BigInt productTree(const vector<uint32_t>& words, size_t lo, size_t hi, int threads) {
+        if (hi - lo <= 32) {
+            BigInt r(1);
+            for (size_t i = lo; i < hi; i++) r.mulSmall(words[i]);
+            return r;
+        }
+        size_t mid = (lo + hi) / 2;
+        BigInt left, right;
+        if (threads > 1) {
+            thread worker([&]() { left = productTree(words, lo, mid, threads / 2); });
+            right = productTree(words, mid, hi, threads - threads / 2);
+            worker.join();
+        } else {
+            left = productTree(words, lo, mid, 1);
+            right = productTree(words, mid, hi, 1);
+        }
+        return BigInt::multiply(left, right, threads);
+    }
+
+    BigInt product(const vector<uint32_t>& factors, int threads) const {
+        vector<uint32_t> words = packFactors(factors);
+        return productTree(words, 0, words.size(), threads);
+    }
+
+    // Odd part of n!: o(n) = o(⌊n/2⌋)² · swing(n) with the factor 2 left out
+    BigInt oddFactorial(uint32_t n, int threads) const {
+        if (n < 3) return BigInt(1);
+        BigInt half = oddFactorial(n / 2, threads);
+        vector<uint32_t> swingFactors;
+        for (uint32_t p : primes) {
+            if (p > n) break;
+            uint32_t q = n, f = 1;
+            while ((q /= p) > 0)
+                if (q & 1) f *= p;
+            if (f > 1) swingFactors.push_back(f);
+        }
+        BigInt swing = product(swingFactors, threads);
+        return BigInt::multiply(BigInt::square(half, threads), swing, threads);
+    }
+
+public:
+    explicit BigFactorial(int threads = 0) {
+        numThreads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+    }
+
+    int threads() const { return numThreads; }
+
+    // r = r·k for k = 2..n
+    BigInt naive(int n) const {
+        if (n < 0) {
+            cout << "Factorial is not defined for negative numbers." << endl;
+            return BigInt(0);
+        }
+        BigInt r(1);
+        for (int k = 2; k <= n; k++) r.mulSmall(k);
+        return r;
+    }
+
+    // Balanced product tree over 2..n
+    BigInt binarySplitting(int n) const {
+        if (n < 0) {
+            cout << "Factorial is not defined for negative numbers." << endl;
+            return BigInt(0);
+        }
+        vector<uint32_t> factors;
+        for (int k = 2; k <= n; k++) factors.push_back(k);
+        return product(factors, numThreads);
+    }
+
+    // n! = 2^(n - popcount n) · o(n)
+    BigInt primeSwing(int n) {
+        if (n < 0) {
+            cout << "Factorial is not defined for negative numbers." << endl;
+            return BigInt(0);
+        }
+        sieve(n);
+        BigInt r = oddFactorial(n, numThreads);
+        r.shiftLeft(n - __builtin_popcount(n));
+        return r;
+    }
+};
+
+// O(1) log n! and a Stirling-series lgamma
+class LogFactorial {
+private:
+    static const int tableSize = 1024;
+    vector<double> table;   // log n! for n < tableSize
+
+    // The asymptotic tail 1/(12x) - 1/(360x³) + ..., for x ≥ 10
+    static double stirlingSeries(double x) {
+        double inv = 1 / x, inv2 = inv * inv;
+        return inv * (1.0 / 12 - inv2 * (1.0 / 360 - inv2 * (1.0 / 1260 - inv2 * (1.0 / 1680 - inv2 * (1.0 / 1188 - inv2 * (691.0 / 360360))))));
+    }
+
+    // ln Γ(x) for x ≥ 10
+    static double stirling(double x) {
+        return (x - 0.5) * log(x) - x + 0.91893853320467274178 + stirlingSeries(x);   // ½ ln 2π
+    }
+
+    // δ(m) = log m! - (m + ½)ln m + m - ½ln 2π, for m ≥ 1
+    double stirlingError(long long m) const {
+        if (m >= 10) return stirlingSeries(static_cast<double>(m));
+        double x = static_cast<double>(m);
+        return table[m] - (x + 0.5) * log(x) + x - 0.91893853320467274178;
+    }
+
+    // bd0(x, μ) = x ln(x/μ) + μ - x ≥ 0 without cancellation (Loader 2000)
+    static double deviance(double x, double mu) {
+        if (fabs(x - mu) >= 0.1 * (x + mu)) return x * log(x / mu) + mu - x;
+        double v = (x - mu) / (x + mu), sum = (x - mu) * v, term = 2 * x * v;
+        v *= v;
+        for (int j = 1; j < 1000; j++) {
+            term *= v;
+            double next = sum + term / (2 * j + 1);
+            if (next == sum) break;
+            sum = next;
+        }
+        return sum;
+    }
+
+public:
+    LogFactorial() {
+        table.resize(tableSize);
+        long double sum = 0;
+        table[0] = 0;
+        for (int n = 1; n < tableSize; n++) {
+            sum += logl(static_cast<long double>(n));
+            table[n] = static_cast<double>(sum);
+        }
+    }
+
+    double logFactorial(long long n) const {
+        if (n < 0) return NAN;
+        if (n < tableSize) return table[n];
+        return stirling(static_cast<double>(n) + 1);
+    }
+
+    double logBinomial(long long n, long long k) const {
+        if (k < 0 || k > n) return -INFINITY;
+        if (n < tableSize) return table[n] - table[k] - table[n - k];   // small terms, little cancellation
+        if (k == 0 || k == n) return 0;
+        double x = static_cast<double>(n), a = static_cast<double>(k), b = static_cast<double>(n - k);
+        return stirlingError(n) - stirlingError(k) - stirlingError(n - k) - 0.5 * log(2 * M_PI * a * (b / x))
+               + a * log1p(b / a) + b * log1p(a / b);   // k ln(n/k) + (n-k) ln(n/(n-k))
+    }
+
+    // log P(X = k) for X ~ Binomial(n, p), accurate to a few ulps of P even where log C(n, k) ≈ n ln 2 ≫ 1
+    double logBinomialProbability(long long n, long long k, double p) const {
+        if (!(p >= 0 && p <= 1)) return NAN;
+        if (k < 0 || k > n) return -INFINITY;
+        double q = 1 - p;
+        if (k == 0) return p == 0 ? 0 : static_cast<double>(n) * log1p(-p);
+        if (k == n) return q == 0 ? 0 : static_cast<double>(n) * log(p);
+        if (p == 0 || q == 0) return -INFINITY;
+        double x = static_cast<double>(n), a = static_cast<double>(k), b = static_cast<double>(n - k);
+        return stirlingError(n) - stirlingError(k) - stirlingError(n - k) - deviance(a, x * p) - deviance(b, x * q)
+               - 0.5 * log(2 * M_PI * a * (b / x));
+    }
+
+    static double logGamma(double x) {
+        if (x <= 0 && x == floor(x)) return INFINITY;   // poles
+        if (x < 0.5) return log(M_PI / fabs(sin(M_PI * x))) - logGamma(1 - x);
+        double shift = 1;
+        while (x < 10) {
+            shift *= x;
+            x += 1;
+        }
+        return stirling(x) - log(shift);
+    }
+};
+
+long long factorialIterative(int n) {
+    if (n < 0) return -1;
+    long long result = 1;
+    for (int i = 2; i <= n; i++) result *= i;   // wraps from 21! on (as in 4BasicProgrammingProblems.cpp)
+    return result;
+}
+
+template <typename F>
+double secondsOf(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// n! mod m by direct multiplication, for checking
+uint32_t factorialMod(int n, uint32_t m) {
+    uint64_t r = 1;
+    for (int k = 2; k <= n; k++) r = r * k % m;
+    return static_cast<uint32_t>(r);
+}
+
+int main() {
+    cout << "=== BIG-INTEGER FACTORIAL ===" << endl;
+    BigFactorial single(1), parallel;
+    LogFactorial lf;
+
+    cout << "\n=== long long VERSUS BigInt ===" << endl;
+    cout << setw(4) << "n" << setw(24) << "long long" << "  " << "exact" << endl;
+    for (int n : {20, 21, 22, 25}) {
+        cout << setw(4) << n << setw(24) << factorialIterative(n) << "  " << single.primeSwing(n).toString() << endl;
+    }
+    string hundred = single.primeSwing(100).toString();
+    cout << "100! = " << hundred.substr(0, 40) << "... (" << hundred.size() << " digits)" << endl;
+    cout << "1000! has " << single.binarySplitting(1000).toString().size() << " digits" << endl;
+
+    cout << "\n=== TIMING (one thread) ===" << endl;
+    cout << setw(9) << "n" << setw(12) << "bits" << setw(12) << "naive[s]" << setw(14) << "splitting[s]"
+         << setw(12) << "swing[s]" << setw(8) << "equal" << endl;
+    for (int n : {1000, 10000, 100000, 1000000}) {
+        BigInt a, b, c;
+        double tNaive = NAN;
+        if (n <= 100000) tNaive = secondsOf([&]() { a = single.naive(n); });
+        double tSplit = secondsOf([&]() { b = single.binarySplitting(n); });
+        double tSwing = secondsOf([&]() { c = single.primeSwing(n); });
+        bool equal = (b == c) && (n > 100000 || a == c);
+        cout << setw(9) << n << setw(12) << c.bitLength() << fixed << setprecision(4);
+        if (n <= 100000) cout << setw(12) << tNaive;
+        else cout << setw(12) << "-";
+        cout << setw(14) << tSplit << setw(12) << tSwing << setw(8) << (equal ? "yes" : "NO") << endl;
+        cout.unsetf(ios::fixed);
+    }
+
+    cout << "\n=== 1000000! ===" << endl;
+    const int big = 1000000;
+    BigInt f;
+    double tParallel = secondsOf([&]() { f = parallel.primeSwing(big); });
+    cout << "Prime swing with " << parallel.threads() << " thread(s): " << fixed << setprecision(4) << tParallel << " s, "
+         << f.limbCount() << " limbs" << endl;
+    cout.unsetf(ios::fixed);
+    bool residuesMatch = true;
+    for (uint32_t m : {2147483647u, 4294967291u, 4000000007u}) {
+        bool ok = f.mod(m) == factorialMod(big, m);
+        residuesMatch = residuesMatch && ok;
+        cout << "  mod " << setw(10) << m << ": " << setw(10) << f.mod(m) << (ok ? "  (matches direct product)" : "  MISMATCH") << endl;
+    }
+    long double exact = f.log10Value();
+    long double fromLog = lf.logFactorial(big) / logl(10.0L);
+    long long digits = static_cast<long long>(floorl(exact)) + 1;
+    long long trailingZeros = 0;
+    for (long long p5 = 5; p5 <= big; p5 *= 5) trailingZeros += big / p5;
+    cout << setprecision(12) << "  leading digits " << powl(10.0L, exact - floorl(exact)) << " (from BigInt), "
+         << powl(10.0L, fromLog - floorl(fromLog)) << " (from log n!)" << endl;
+    cout << "  " << digits << " decimal digits, " << trailingZeros << " trailing zeros"
+         << (residuesMatch ? "" : "; RESIDUE CHECK FAILED") << endl;
+
+    cout << "\n=== log n! AND lgamma ===" << endl;
+    double maxError = 0;
+    for (double x = -9.75; x < 200; x += 0.0625) {
+        if (x <= 0 && x == floor(x)) continue;
+        double ref = lgamma(x);
+        maxError = max(maxError, fabs(LogFactorial::logGamma(x) - ref) / max(1.0, fabs(ref)));
+    }
+    cout << "logGamma vs std::lgamma on [-9.75, 200): max error " << setprecision(3) << maxError
+         << " (relative, absolute where |lgamma| < 1)" << endl;
+    double maxFactorialError = 0;
+    for (long long n = 0; n < 100000; n += 7) {
+        double ref = lgamma(static_cast<double>(n) + 1);
+        maxFactorialError = max(maxFactorialError, fabs(lf.logFactorial(n) - ref) / max(1.0, ref));
+    }
+    cout << "logFactorial vs std::lgamma(n + 1), n < 1e5: max relative error " << maxFactorialError << endl;
+
+    const int queries = 10000000;
+    double sink = 0;
+    double tTable = secondsOf([&]() {
+        for (int i = 0; i < queries; i++) sink += lf.logFactorial(i & 1023);
+    });
+    double tStirling = secondsOf([&]() {
+        for (int i = 0; i < queries; i++) sink += lf.logFactorial(1024 + i);
+    });
+    double tLibm = secondsOf([&]() {
+        for (int i = 0; i < queries; i++) sink += lgamma(1025.0 + i);
+    });
+    cout << "Per query: table " << setprecision(3) << 1e9 * tTable / queries << " ns, Stirling "
+         << 1e9 * tStirling / queries << " ns, std::lgamma " << 1e9 * tLibm / queries << " ns"
+         << (sink == 0 ? " " : "") << endl;
+
+    // Statistics: binomial probabilities far beyond the range of n! in double
+    // P(X = n/2) = √(2/(πn)) · (1 - 1/(4n) + 1/(32n²) + ...) for even n
+    cout << "\nBinomial(n, 1/2) at its mode: saddle point, naive exp(log n! - 2 log (n/2)! - n ln 2), and\n"
+         << "the series √(2/(πn))(1 - 1/(4n) + 1/(32n²)):" << endl;
+    cout << setw(12) << "n" << setw(18) << "saddle point" << setw(18) << "naive" << setw(18) << "series" << endl;
+    for (long long n : {100LL, 10000LL, 1000000LL, 100000000LL}) {
+        double p = exp(lf.logBinomialProbability(n, n / 2, 0.5));
+        double naive = exp(lf.logFactorial(n) - 2 * lf.logFactorial(n / 2) - n * log(2.0));
+        double x = static_cast<double>(n);
+        double series = sqrt(2 / (M_PI * x)) * (1 - 1 / (4 * x) + 1 / (32 * x * x));
+        cout << setw(12) << n << setprecision(10) << setw(18) << p << setw(18) << naive << setw(18) << series << endl;
+    }
+    cout << "log C(10⁸, 5·10⁷) = " << setprecision(17) << lf.logBinomial(100000000, 50000000) << " (saddle point), "
+         << lf.logFactorial(100000000) - 2 * lf.logFactorial(50000000) << " (difference of log n!)" << endl;
+
+    cout << "\nPrime swing computes 10⁶! with about 20 squarings and one small product tree, and NTT" << endl;
+    cout << "multiplication keeps each of them near-linear. Threads split the product tree and the three NTT" << endl;
+    cout << "primes, so they only pay off on multi-core machines." << endl;
+
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*Compile-Time Tables: Factorials, Binomials, Stirling Numbers and Difference-to-Derivative Coefficients
+newtonForwardDerivative in 10NewtonInterpolationFormulas.cpp hard-codes the series
+h·f'(x₀) = Δy₀ - ½Δ²y₀ + ⅓Δ³y₀ - ¼Δ⁴y₀ + ...
+17DividedDifferenceInterpolation.cpp rebuilds m! in a loop, and Newton–Gregory interpolation computes
+C(p, j) = p(p-1)···(p-j+1)/j! with one division per term. These numbers never change. Here the compiler generates
+them once: each table is a constexpr object filled by ordinary loops in a constexpr constructor, sized by a template
+parameter and checked with static_assert. At run time a kernel only reads the tables.
+
+Operator calculus behind the derivative tables (E = shift by h, D = d/dx):
+E = e^(hD), Δ = E - 1, so hD = ln(1 + Δ) and (hD)ᵏ = ln(1 + Δ)ᵏ = k!·Σ_{m≥k} s(m, k)·Δᵐ/m!,
+where s(m, k) are the signed Stirling numbers of the first kind. Hence
+hᵏ f⁽ᵏ⁾(x₀) ≈ Σ_{m=k}^{M} Fₖₘ·Δᵐy₀,   Fₖₘ = k!·s(m, k)/m!      (F₁ₘ = (-1)^(m-1)/m is the series above)
+hᵏ f⁽ᵏ⁾(xₙ) ≈ Σ_{m=k}^{M} Bₖₘ·∇ᵐyₙ,   Bₖₘ = k!·|s(m, k)|/m!     (from hD = -ln(1 - ∇))
+In the other direction, Δᵐ = (e^(hD) - 1)ᵐ = m!·Σₖ S(k, m)·(hD)ᵏ/k!, where S are the Stirling numbers of the second kind.
+
+Newton–Gregory forward interpolation: f(x₀ + ph) ≈ Σⱼ C(p, j)·Δʲy₀ with C(p, j) = Σₖ s(j, k)·pᵏ/j!. The table of
+s(j, k)/j! turns the differences into power-series coefficients in p once, so each evaluation is a division-free
+Horner loop.
+
+Recurrences, with the ranges in which they stay exact (enforced by static_assert):
+n! = n·(n-1)!                          64-bit integers up to 20!, long double rounded to double up to 170!
+C(n, k) = C(n-1, k-1) + C(n-1, k)      64-bit integers up to n = 67
+s(n+1, k) = s(n, k-1) - n·s(n, k)      64-bit integers up to n = 20
+S(n+1, k) = k·S(n, k) + S(n, k-1)      64-bit integers up to n = 20
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+using namespace std;
+
+template <int N>
+struct FactorialTable {
+    static_assert(N >= 0 && N <= 170, "n! overflows double beyond 170!");
+    uint64_t exact[N + 1];    // n! for n ≤ 20, 0 beyond
+    double value[N + 1];      // n!, rounded once from long double
+    double inverse[N + 1];    // 1/n!
+
+    constexpr FactorialTable() : exact(), value(), inverse() {
+        long double f = 1;
+        exact[0] = 1;
+        value[0] = inverse[0] = 1;
+        for (int n = 1; n <= N; n++) {
+            exact[n] = n <= 20 ? exact[n - 1] * n : 0;
+            f *= n;
+            value[n] = static_cast<double>(f);
+            inverse[n] = static_cast<double>(1 / f);
+        }
+    }
+};
+
+template <int N>
+struct BinomialTable {
+    static_assert(N >= 0 && N <= 67, "C(n, k) overflows 64 bits beyond n = 67");
+    uint64_t c[N + 1][N + 1];
+
+    constexpr BinomialTable() : c() {
+        for (int n = 0; n <= N; n++) {
+            c[n][0] = 1;
+            for (int k = 1; k <= n; k++) c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+        }
+    }
+
+    constexpr uint64_t operator()(int n, int k) const { return (k < 0 || k > n) ? 0 : c[n][k]; }
+};
+
+template <int N>
+struct StirlingTable {
+    static_assert(N >= 0 && N <= 20, "Stirling numbers overflow 64 bits beyond n = 20");
+    int64_t first[N + 1][N + 1];    // signed s(n, k)
+    int64_t second[N + 1][N + 1];   // S(n, k)
+
+    constexpr StirlingTable() : first(), second() {
+        first[0][0] = second[0][0] = 1;
+        for (int n = 0; n < N; n++) {
+            for (int k = 1; k <= n + 1; k++) {
+                first[n + 1][k] = first[n][k - 1] - n * first[n][k];
+                second[n + 1][k] = k * second[n][k] + second[n][k - 1];
+            }
+        }
+    }
+};
+
+// Coefficients of the difference calculus up to order M:
+// forward[k][m] = k!·s(m, k)/m!, backward[k][m] = k!·|s(m, k)|/m!, gregory[j][k] = s(j, k)/j!
+template <int M>
+struct DifferenceCalculusTable {
+    double forward[M + 1][M + 1];
+    double backward[M + 1][M + 1];
+    double gregory[M + 1][M + 1];
+
+    constexpr DifferenceCalculusTable() : forward(), backward(), gregory() {
+        StirlingTable<M> s;
+        FactorialTable<M> f;
+        for (int m = 0; m <= M; m++) {
+            for (int k = 0; k <= m; k++) {
+                // s(m, k) and m!/k! are exact in long double, so each entry is rounded only once
+                long double falling = static_cast<long double>(f.exact[m] / f.exact[k]);
+                long double ratio = static_cast<long double>(s.first[m][k]) / falling;
+                forward[k][m] = static_cast<double>(ratio);
+                backward[k][m] = static_cast<double>(ratio < 0 ? -ratio : ratio);
+                gregory[m][k] = static_cast<double>(static_cast<long double>(s.first[m][k]) / f.exact[m]);
+            }
+        }
+    }
+};
+
+// The tables used below, built by the compiler
+constexpr FactorialTable<170> factorials;
+constexpr BinomialTable<67> binomials;
+constexpr StirlingTable<20> stirling;
+template <int M>
+constexpr DifferenceCalculusTable<M> calculus;
+
+static_assert(factorials.exact[20] == 2432902008176640000ull, "20!");
+static_assert(binomials(67, 33) == 14226520737620288370ull, "C(67, 33)");
+static_assert(stirling.first[5][2] == -50 && stirling.second[5][2] == 15, "s(5, 2), S(5, 2)");
+static_assert(calculus<4>.forward[1][2] == -0.5 && calculus<4>.forward[1][4] == -0.25, "the series of 10.cpp");
+static_assert(calculus<4>.forward[2][3] == -1 && calculus<4>.forward[2][4] == 11.0 / 12, "h²f'' = Δ² - Δ³ + 11/12Δ⁴");
+
+// hᵏ·f⁽ᵏ⁾(x₀) from the forward differences Δᵐy₀, m = 0..M; O(M) table lookups
+template <int M>
+double derivativeFromForward(const double* delta, int k, double h) {
+    double sum = 0;
+    for (int m = k; m <= M; m++) sum += calculus<M>.forward[k][m] * delta[m];
+    return sum / pow(h, k);
+}
+
+// Same from the backward differences ∇ᵐyₙ at the last sample
+template <int M>
+double derivativeFromBackward(const double* nabla, int k, double h) {
+    double sum = 0;
+    for (int m = k; m <= M; m++) sum += calculus<M>.backward[k][m] * nabla[m];
+    return sum / pow(h, k);
+}
+
+// Without tables: s(m, k) rebuilt by the recurrence on every call, as a runtime generator would
+double derivativeRecomputed(const double* delta, int M, int k, double h) {
+    vector<vector<double>> s(M + 1, vector<double>(M + 1, 0));
+    s[0][0] = 1;
+    for (int n = 0; n < M; n++)
+        for (int j = 1; j <= n + 1; j++) s[n + 1][j] = s[n][j - 1] - n * s[n][j];
+    double sum = 0, ratio = 1;   // ratio = k!/m!
+    for (int m = k; m <= M; m++) {
+        if (m > k) ratio /= m;
+        sum += ratio * s[m][k] * delta[m];
+    }
+    return sum / pow(h, k);
+}
+
+// Newton–Gregory forward interpolation of degree M through y(x₀), ..., y(x₀ + Mh)
+template <int M>
+class NewtonGregory {
+private:
+    double x0, h;
+    double delta[M + 1];   // Δʲy₀
+    double power[M + 1];   // coefficients of pᵏ: Σⱼ s(j, k)/j!·Δʲy₀
+
+public:
+    NewtonGregory(double start, double step, const double* y) {
+        x0 = start;
+        h = step;
+        double work[M + 1];
+        for (int i = 0; i <= M; i++) work[i] = y[i];
+        for (int j = 0; j <= M; j++) {
+            delta[j] = work[0];
+            for (int i = 0; i < M - j; i++) work[i] = work[i + 1] - work[i];
+        }
+        for (int k = 0; k <= M; k++) {
+            power[k] = 0;
+            for (int j = k; j <= M; j++) power[k] += calculus<M>.gregory[j][k] * delta[j];
+        }
+    }
+
+    // Horner in p, no divisions
+    double operator()(double x) const {
+        double p = (x - x0) / h;
+        double r = power[M];
+        for (int k = M - 1; k >= 0; k--) r = r * p + power[k];
+        return r;
+    }
+
+    // Term by term: C(p, j) = C(p, j-1)·(p - j + 1)/j
+    double binomialSum(double x) const {
+        double p = (x - x0) / h;
+        double term = 1, sum = delta[0];
+        for (int j = 1; j <= M; j++) {
+            term *= (p - j + 1) / j;
+            sum += term * delta[j];
+        }
+        return sum;
+    }
+
+    const double* differences() const { return delta; }
+};
+
+template <typename F>
+double secondsOf(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Δᵐy₀ (or ∇ᵐyₙ with backward = true) of f sampled at x₀ + ih
+template <typename F>
+vector<double> sampledDifferences(F f, double x0, double h, int M, bool backward) {
+    vector<double> work(M + 1), diff(M + 1);
+    for (int i = 0; i <= M; i++) work[i] = f(x0 + (backward ? i - M : i) * h);
+    for (int m = 0; m <= M; m++) {
+        diff[m] = backward ? work[M - m] : work[0];
+        for (int i = 0; i < M - m; i++) work[i] = work[i + 1] - work[i];
+    }
+    return diff;
+}
+
+int main() {
+    cout << "=== COMPILE-TIME TABLES ===" << endl;
+    cout << "Sizes: factorials to 170 (" << sizeof(factorials) << " bytes), binomials to 67 (" << sizeof(binomials)
+         << " bytes), Stirling to 20 (" << sizeof(stirling) << " bytes), all built by the compiler" << endl;
+    cout << "20! = " << factorials.exact[20] << ", 170! = " << factorials.value[170]
+         << ", C(67, 33) = " << binomials(67, 33) << endl;
+
+    cout << "\nStirling numbers s(n, k) | S(n, k):" << endl;
+    for (int n = 1; n <= 6; n++) {
+        cout << "n = " << n << ":";
+        for (int k = 1; k <= 6; k++) cout << setw(6) << (k <= n ? to_string(stirling.first[n][k]) : "");
+        cout << "  |";
+        for (int k = 1; k <= n; k++) cout << setw(5) << stirling.second[n][k];
+        cout << endl;
+    }
+
+    cout << "\nForward-difference weights hᵏf⁽ᵏ⁾(x₀) = Σ Fₖₘ Δᵐy₀ (row k, column m):" << endl;
+    for (int k = 1; k <= 4; k++) {
+        cout << "k = " << k << ":";
+        for (int m = 1; m <= 8; m++) cout << setw(10) << setprecision(5) << calculus<8>.forward[k][m];
+        cout << endl;
+    }
+
+    cout << "\n=== DERIVATIVES OF exp(x) AT x₀ = 0.3 FROM DIFFERENCES, h = 0.05 ===" << endl;
+    auto f = [](double x) { return exp(x); };
+    const double x0 = 0.3, h = 0.05;
+    vector<double> d4 = sampledDifferences(f, x0, h, 4, false), d8 = sampledDifferences(f, x0, h, 8, false);
+    vector<double> d12 = sampledDifferences(f, x0, h, 12, false), b8 = sampledDifferences(f, x0, h, 8, true);
+    cout << setw(4) << "k" << setw(14) << "exact" << setw(14) << "M = 4 err" << setw(14) << "M = 8 err"
+         << setw(14) << "M = 12 err" << setw(16) << "backward M = 8" << endl;
+    for (int k = 1; k <= 4; k++) {
+        double exact = exp(x0);
+        cout << setw(4) << k << setw(14) << setprecision(8) << exact << scientific << setprecision(2)
+             << setw(14) << derivativeFromForward<4>(d4.data(), k, h) - exact
+             << setw(14) << derivativeFromForward<8>(d8.data(), k, h) - exact
+             << setw(14) << derivativeFromForward<12>(d12.data(), k, h) - exact
+             << setw(16) << derivativeFromBackward<8>(b8.data(), k, h) - exact << defaultfloat << endl;
+    }
+    cout << "(the backward column uses ∇ᵐy at x₀ itself, built from samples to the left)" << endl;
+
+    cout << "\n=== NEWTON–GREGORY INTERPOLATION OF sin(x) ON [0, 1], DEGREE 10 ===" << endl;
+    const int degree = 10;
+    double samples[degree + 1];
+    const double step = 0.1;
+    for (int i = 0; i <= degree; i++) samples[i] = sin(i * step);
+    NewtonGregory<degree> ng(0.0, step, samples);
+    const int points = 2000000;
+    double maxError = 0, maxGap = 0;
+    for (int i = 0; i <= 1000; i++) {
+        double x = i * 1e-3;
+        maxError = max(maxError, fabs(ng(x) - sin(x)));
+        maxGap = max(maxGap, fabs(ng(x) - ng.binomialSum(x)));
+    }
+    double sink = 0;
+    double tHorner = secondsOf([&]() {
+        for (int i = 0; i < points; i++) sink += ng(i * (1.0 / points));
+    });
+    double tBinomial = secondsOf([&]() {
+        for (int i = 0; i < points; i++) sink += ng.binomialSum(i * (1.0 / points));
+    });
+    cout << "max |p(x) - sin x| = " << scientific << setprecision(2) << maxError
+         << ", table Horner vs Σ C(p, j)Δʲy₀: " << maxGap << defaultfloat << endl;
+    cout << "Per evaluation: table Horner " << setprecision(3) << 1e9 * tHorner / points << " ns, binomial terms "
+         << 1e9 * tBinomial / points << " ns" << endl;
+
+    cout << "\n=== COEFFICIENTS: TABLE LOOKUP VERSUS RUNTIME GENERATION ===" << endl;
+    const int calls = 1000000;
+    double tTable = secondsOf([&]() {
+        for (int i = 0; i < calls; i++) sink += derivativeFromForward<12>(d12.data(), 1 + (i & 3), h);
+    });
+    double tRuntime = secondsOf([&]() {
+        for (int i = 0; i < calls; i++) sink += derivativeRecomputed(d12.data(), 12, 1 + (i & 3), h);
+    });
+    double gap = 0;
+    for (int k = 1; k <= 4; k++) {
+        double a = derivativeFromForward<12>(d12.data(), k, h), b = derivativeRecomputed(d12.data(), 12, k, h);
+        gap = max(gap, fabs(a - b) / fabs(a));
+    }
+    cout << "Derivative of order 1-4 from 12 differences: table " << 1e9 * tTable / calls << " ns, recomputed "
+         << 1e9 * tRuntime / calls << " ns per call (relative difference " << scientific << setprecision(1) << gap
+         << ")" << defaultfloat << (sink == 0 ? " " : "") << endl;
+
+    cout << "\nEvery coefficient above was computed during compilation. Raising the order is a template argument," << endl;
+    cout << "and the static_asserts reject sizes at which a 64-bit table entry would overflow." << endl;
+
+    return 0;
+}
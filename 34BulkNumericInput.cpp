@@ -0,0 +1,597 @@
+/*Bulk Numeric Input: Memory-Mapped Text with Parallel from_chars, and a Zero-Copy Binary Column Format
+Every program here reads its input with cin >> one value at a time (the coefficient prompts and the element loops of
+4BasicProgrammingProblems.cpp). Each >> builds a sentry and goes through the locale's num_get facet and the stream
+buffer, so loading a million-point dataset takes longer than the computation on it.
+
+Text loader (CSV or whitespace-separated columns):
+- The file is memory-mapped and parsed in place, without copying it through stream buffers.
+- The format comes from the first data line: a comma makes it CSV, otherwise fields are separated by blanks or tabs.
+  If that line does not start with a number it is a header and names the columns. Blank lines and lines starting
+  with '#' are skipped. In CSV an empty field is NaN.
+- The text is cut into chunks at line boundaries, and threads claim the chunks through an atomic counter.
+  Pass 1 counts the data lines of every chunk (memchr finds the newlines). A prefix sum gives each chunk its first
+  row. Pass 2 parses the chunks in parallel with std::from_chars and writes every value straight to columns[c][row].
+- from_chars ignores the locale, never allocates and rounds correctly, so text written with to_chars or "%.17g"
+  reads back bit for bit. A line with the wrong number of fields or a malformed number stops the load, and the
+  message gives its line number.
+
+Binary column format (native byte order, little-endian on x86 and ARM):
+  header:  "COL1", uint32 columns, uint64 rows
+  data:    column 0 as rows doubles, then column 1, ...
+- The header is 16 bytes, so every column is 8-byte aligned in the mapping. The reader returns const double*
+  pointers into the mapped file. Opening costs one mmap, pages are read on first touch, and nothing is parsed or
+  copied.
+- TRJ1 in 24TrajectoryWriter.cpp interleaves the columns in blocks as they are produced and may compress them.
+  Here each column is one contiguous array, which is what the kernels in the other files take.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Runs body(block) for blocks 0..blocks-1 on numThreads threads (as in 28MonteCarloIntegration.cpp)
+void parallelBlocks(int blocks, int numThreads, const function<void(int)>& body) {
+    atomic<int> next(0);
+    auto worker = [&]() {
+        for (int b = next++; b < blocks; b = next++) body(b);
+    };
+    vector<thread> pool;
+    for (int t = 1; t < min(numThreads, blocks); t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+// Read-only mapping of a whole file (as in TrajectoryReader, 24TrajectoryWriter.cpp)
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+
+public:
+    explicit MappedFile(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            cout << "Cannot open " << path << "." << endl;
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            cout << "Cannot open " << path << "." << endl;
+            ::close(fd);
+            return;
+        }
+        size = st.st_size;
+        void* mapped = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            cout << "Cannot map " << path << (size == 0 ? " (empty file)." : ".") << endl;
+            size = 0;
+            return;
+        }
+        data = static_cast<const char*>(mapped);
+        madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+    const char* bytes() const { return data; }
+    size_t length() const { return size; }
+};
+
+struct NumericTable {
+    bool ok = false;
+    vector<string> names;             // from the header line, empty without one
+    vector<vector<double>> columns;   // columns[c][row]
+    size_t rows = 0;
+    string error;
+};
+
+class TextTableLoader {
+private:
+    int numThreads;
+
+    static const size_t chunkBytes = 1 << 20;
+
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        size_t lines = 0, rows = 0;            // pass 1
+        size_t firstLine = 0, firstRow = 0;    // prefix sums
+        size_t errorLine = 0;                  // chunk-local line of the first error, 0 = none
+        string error;
+    };
+
+    static const char* skipBlanks(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        return p;
+    }
+
+    static const char* lineEnd(const char* p, const char* end) {
+        const char* q = static_cast<const char*>(memchr(p, '\n', end - p));
+        return q ? q : end;
+    }
+
+    static bool isDataLine(const char* p, const char* end) {
+        p = skipBlanks(p, end);
+        return p < end && *p != '\n' && *p != '#';
+    }
+
+    // One number at p. from_chars takes no leading '+' and reports values beyond the double range as an error; those
+    // rare tokens go through strtod, which rounds them to ±inf or 0.
+    static const char* parseNumber(const char* p, const char* end, double& value) {
+        const char* start = p;
+        if (p < end && *p == '+') p++;
+        if (p < end && *p == '-' && p > start) return nullptr;
+        from_chars_result r = from_chars(p, end, value);
+        if (r.ec == errc()) return r.ptr;
+        if (r.ec != errc::result_out_of_range) return nullptr;
+        char token[128];
+        size_t length = min<size_t>(r.ptr - start, sizeof token - 1);
+        memcpy(token, start, length);
+        token[length] = '\0';
+        value = strtod(token, nullptr);
+        return r.ptr;
+    }
+
+    // Splits the first data line into trimmed fields
+    static vector<string> splitFields(const char* p, const char* end, bool csv) {
+        vector<string> fields;
+        p = skipBlanks(p, end);
+        while (true) {
+            const char* q = p;
+            if (csv) {
+                while (q < end && *q != ',') q++;
+            } else {
+                while (q < end && *q != ' ' && *q != '\t' && *q != '\r') q++;
+            }
+            const char* last = q;
+            while (last > p && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) last--;
+            fields.emplace_back(p, last);
+            if (q == end) break;
+            p = skipBlanks(csv ? q + 1 : q, end);
+            if (p == end) {
+                if (csv) fields.emplace_back();   // trailing comma: one more empty field
+                break;
+            }
+        }
+        return fields;
+    }
+
+    // Pass 2 for one chunk: rows go to columns[c][chunk.firstRow + k]
+    static void parseChunk(Chunk& chunk, bool csv, vector<double*>& columns) {
+        const int numColumns = static_cast<int>(columns.size());
+        size_t row = chunk.firstRow, line = 0;
+        for (const char* p = chunk.begin; p < chunk.end; line++) {
+            const char* eol = lineEnd(p, chunk.end);
+            if (isDataLine(p, eol)) {
+                const char* q = p;
+                for (int c = 0; c < numColumns; c++) {
+                    q = skipBlanks(q, eol);
+                    if (csv && c > 0) {
+                        if (q == eol || *q != ',') {
+                            chunk.error = "expected " + to_string(numColumns) + " fields, found " + to_string(c);
+                            break;
+                        }
+                        q = skipBlanks(q + 1, eol);
+                    }
+                    double value;
+                    if (csv && (q == eol || *q == ',')) {
+                        value = NAN;   // empty field
+                    } else if (q == eol) {
+                        chunk.error = "expected " + to_string(numColumns) + " fields, found " + to_string(c);
+                        break;
+                    } else {
+                        const char* after = parseNumber(q, eol, value);
+                        if (!after || (after < eol && *after != ' ' && *after != '\t' && *after != '\r' &&
+                                       !(csv && *after == ','))) {
+                            const char* tokenEnd = q;
+                            while (tokenEnd < eol && *tokenEnd != ',' && *tokenEnd != ' ' && *tokenEnd != '\t' &&
+                                   *tokenEnd != '\r') tokenEnd++;
+                            chunk.error = "cannot parse \"" + string(q, tokenEnd) + "\" as a number";
+                            break;
+                        }
+                        q = after;
+                    }
+                    columns[c][row] = value;
+                }
+                if (chunk.error.empty() && skipBlanks(q, eol) != eol)
+                    chunk.error = "more than " + to_string(numColumns) + " fields";
+                if (!chunk.error.empty()) {
+                    chunk.errorLine = line + 1;
+                    return;
+                }
+                row++;
+            }
+            p = eol + 1;
+        }
+    }
+
+public:
+    explicit TextTableLoader(int threads = 0) {
+        numThreads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+    }
+
+    int threads() const { return numThreads; }
+
+    NumericTable load(const string& path) const {
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            NumericTable table;
+            table.error = "cannot map " + path;
+            return table;
+        }
+        return parse(file.bytes(), file.length());
+    }
+
+    NumericTable parse(const char* text, size_t size) const {
+        NumericTable table;
+        const char* end = text + size;
+
+        // First data line: format, column count and optional header
+        const char* body = text;
+        size_t headerLines = 0;
+        while (body < end && !isDataLine(body, lineEnd(body, end))) {
+            body = lineEnd(body, end) + 1;
+            headerLines++;
+        }
+        if (body >= end) {
+            table.error = "no data";
+            return table;
+        }
+        const char* firstEnd = lineEnd(body, end);
+        bool csv = memchr(body, ',', firstEnd - body) != nullptr;
+        vector<string> fields = splitFields(body, firstEnd, csv);
+        double probe;
+        const char* first = fields[0].c_str();
+        if (!fields[0].empty() && !parseNumber(first, first + fields[0].size(), probe)) {
+            table.names = fields;
+            body = firstEnd + 1;
+            headerLines++;
+        }
+        const int numColumns = static_cast<int>(fields.size());
+        if (body > end) body = end;
+
+        // Chunks start after a newline
+        size_t bytes = end - body;
+        int numChunks = static_cast<int>(max<size_t>(1, min<size_t>(bytes / chunkBytes, 64 * numThreads)));
+        vector<Chunk> chunks(numChunks);
+        const char* previous = body;
+        for (int k = 0; k < numChunks; k++) {
+            chunks[k].begin = previous;
+            const char* split = k + 1 == numChunks ? end : body + bytes * (k + 1) / numChunks;
+            if (split < previous) split = previous;
+            if (split < end && split > body && split[-1] != '\n') split = min(end, lineEnd(split, end) + 1);
+            chunks[k].end = split;
+            previous = split;
+        }
+
+        // Pass 1: data lines per chunk
+        parallelBlocks(numChunks, numThreads, [&](int k) {
+            Chunk& chunk = chunks[k];
+            for (const char* p = chunk.begin; p < chunk.end; chunk.lines++) {
+                const char* eol = lineEnd(p, chunk.end);
+                if (isDataLine(p, eol)) chunk.rows++;
+                p = eol + 1;
+            }
+        });
+        for (int k = 1; k < numChunks; k++) {
+            chunks[k].firstLine = chunks[k - 1].firstLine + chunks[k - 1].lines;
+            chunks[k].firstRow = chunks[k - 1].firstRow + chunks[k - 1].rows;
+        }
+        table.rows = chunks.back().firstRow + chunks.back().rows;
+
+        // Pass 2: parse into the columns
+        table.columns.assign(numColumns, vector<double>(table.rows));
+        vector<double*> columns(numColumns);
+        for (int c = 0; c < numColumns; c++) columns[c] = table.columns[c].data();
+        parallelBlocks(numChunks, numThreads, [&](int k) { parseChunk(chunks[k], csv, columns); });
+
+        for (const Chunk& chunk : chunks) {
+            if (chunk.errorLine > 0) {
+                table.error = "line " + to_string(headerLines + chunk.firstLine + chunk.errorLine) + ": " + chunk.error;
+                table.columns.clear();
+                table.rows = 0;
+                return table;
+            }
+        }
+        table.ok = true;
+        return table;
+    }
+};
+
+bool sameLengths(const vector<vector<double>>& columns) {
+    for (const vector<double>& column : columns) {
+        if (column.size() != columns[0].size()) return false;
+    }
+    return true;
+}
+
+// Memory-mapped reader and writer for the "COL1" format above
+class ColumnFile {
+private:
+    MappedFile file;
+    int columns = 0;
+    size_t rows = 0;
+    bool valid = false;
+
+public:
+    explicit ColumnFile(const string& path) : file(path) {
+        if (!file.isOpen()) return;
+        uint32_t count = 0;
+        uint64_t length = 0;
+        if (file.length() >= 16) {
+            memcpy(&count, file.bytes() + 4, 4);
+            memcpy(&length, file.bytes() + 8, 8);
+        }
+        // count·length·8 can overflow for a damaged header, so the length is bounded by division first
+        uint64_t payload = file.length() >= 16 ? file.length() - 16 : 0;
+        bool sizeMatches = count == 0 ? payload == 0
+                                      : length <= payload / sizeof(double) / count &&
+                                        count * length * sizeof(double) == payload;
+        if (file.length() < 16 || memcmp(file.bytes(), "COL1", 4) != 0 || count > INT32_MAX || !sizeMatches) {
+            cout << path << " is not a column file." << endl;
+            return;
+        }
+        columns = count;
+        rows = length;
+        valid = true;
+    }
+
+    bool isOpen() const { return valid; }
+    int numColumns() const { return columns; }
+    size_t numRows() const { return rows; }
+
+    // Points into the mapping; valid while this object lives
+    const double* column(int c) const {
+        return reinterpret_cast<const double*>(file.bytes() + 16) + c * rows;
+    }
+
+    static bool write(const string& path, const vector<vector<double>>& columns) {
+        if (!sameLengths(columns)) {
+            cout << "Cannot write " << path << ": the columns differ in length." << endl;
+            return false;
+        }
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out) {
+            cout << "Cannot create " << path << "." << endl;
+            return false;
+        }
+        uint32_t count = static_cast<uint32_t>(columns.size());
+        uint64_t length = columns.empty() ? 0 : columns[0].size();
+        bool ok = fwrite("COL1", 1, 4, out) == 4 && fwrite(&count, 4, 1, out) == 1 && fwrite(&length, 8, 1, out) == 1;
+        for (size_t c = 0; c < columns.size() && ok; c++) ok = fwrite(columns[c].data(), sizeof(double), length, out) == length;
+        ok = fclose(out) == 0 && ok;
+        if (!ok) cout << "Write to " << path << " failed." << endl;
+        return ok;
+    }
+};
+
+// Shortest round-trip text for every row, columns separated by separator
+bool writeText(const string& path, const vector<vector<double>>& columns, char separator, const string& header) {
+    if (columns.empty() || !sameLengths(columns)) {
+        cout << "Cannot write " << path << ": no columns, or columns that differ in length." << endl;
+        return false;
+    }
+    string text = header.empty() ? "" : header + "\n";
+    text.reserve(columns.size() * columns[0].size() * 20);
+    char buffer[32];
+    for (size_t row = 0; row < columns[0].size(); row++) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            if (c > 0) text += separator;
+            text.append(buffer, to_chars(buffer, buffer + sizeof buffer, columns[c][row]).ptr);
+        }
+        text += '\n';
+    }
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) {
+        cout << "Cannot create " << path << "." << endl;
+        return false;
+    }
+    bool ok = fwrite(text.data(), 1, text.size(), out) == text.size();
+    ok = fclose(out) == 0 && ok;
+    if (!ok) cout << "Write to " << path << " failed." << endl;
+    return ok;
+}
+
+bool sameBits(const vector<double>& a, const double* b) {
+    return memcmp(a.data(), b, a.size() * sizeof(double)) == 0;
+}
+
+template <typename F>
+double secondsOf(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+size_t fileSize(const string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_size : 0;
+}
+
+void report(const string& name, double seconds, size_t bytes, size_t rows, bool exact) {
+    cout << setw(44) << left << name << right << setw(10) << fixed << setprecision(3) << seconds
+         << setw(12) << setprecision(0) << bytes / seconds / 1e6 << setw(10) << rows
+         << setw(12) << (exact ? "yes" : "NO") << endl;
+}
+
+int main() {
+    TextTableLoader loader;
+    const size_t rows = 1000000;
+    const string textPath = "bulk_input.txt", csvPath = "bulk_input.csv", binaryPath = "bulk_input.col";
+
+    // x, a smooth signal, log-normal measurements and integer counts
+    vector<vector<double>> data(4, vector<double>(rows));
+    for (size_t i = 0; i < rows; i++) {
+        double u1 = ((splitmix64(2 * i) >> 11) + 0.5) * 0x1.0p-53, u2 = (splitmix64(2 * i + 1) >> 11) * 0x1.0p-53;
+        data[0][i] = i * 1e-3;
+        data[1][i] = sin(data[0][i]) * 25 + u2;
+        data[2][i] = exp(sqrt(-2 * log(u1)) * cos(2 * M_PI * u2) * 2);
+        data[3][i] = static_cast<double>(splitmix64(i) % 100000);
+    }
+    if (!writeText(textPath, data, ' ', "") || !writeText(csvPath, data, ',', "x,signal,measurement,count") ||
+        !ColumnFile::write(binaryPath, data)) {
+        return 1;
+    }
+
+    cout << "=== BULK NUMERIC INPUT: " << rows << " ROWS × 4 COLUMNS ===" << endl;
+    cout << "Threads: " << loader.threads() << "; files are in the page cache (written just before)" << endl << endl;
+    cout << setw(44) << left << "method" << right << setw(10) << "seconds" << setw(12) << "MB/s" << setw(10) << "rows"
+         << setw(12) << "bit-exact" << endl;
+    cout << string(88, '-') << endl;
+
+    // The element loop of 4BasicProgrammingProblems.cpp, reading from a file instead of the keyboard
+    {
+        vector<vector<double>> columns(4, vector<double>(rows));
+        size_t count = 0;
+        double t = secondsOf([&]() {
+            ifstream in(textPath);
+            double v[4];
+            while (count < rows && in >> v[0] >> v[1] >> v[2] >> v[3]) {
+                for (int c = 0; c < 4; c++) columns[c][count] = v[c];
+                count++;
+            }
+        });
+        bool exact = count == rows;
+        for (int c = 0; c < 4; c++) exact = exact && sameBits(data[c], columns[c].data());
+        report("ifstream >> (as cin >>), whitespace", t, fileSize(textPath), count, exact);
+    }
+    {
+        vector<vector<double>> columns(4);
+        double t = secondsOf([&]() {
+            ifstream in(csvPath);
+            string line, field;
+            getline(in, line);   // header
+            while (getline(in, line)) {
+                stringstream fields(line);
+                for (int c = 0; c < 4 && getline(fields, field, ','); c++) columns[c].push_back(stod(field));
+            }
+        });
+        bool exact = columns[0].size() == rows;
+        for (int c = 0; c < 4; c++) exact = exact && columns[c].size() == rows && sameBits(data[c], columns[c].data());
+        report("getline + stringstream + stod, CSV", t, fileSize(csvPath), columns[0].size(), exact);
+    }
+
+    auto runLoader = [&](const string& name, const TextTableLoader& l, const string& path) {
+        NumericTable table;
+        double t = secondsOf([&]() { table = l.load(path); });
+        bool exact = table.ok && table.rows == rows && table.columns.size() == 4;
+        for (size_t c = 0; exact && c < 4; c++) exact = sameBits(data[c], table.columns[c].data());
+        report(name, t, fileSize(path), table.rows, exact);
+        if (!table.ok) cout << "  " << table.error << endl;
+    };
+    TextTableLoader serial(1);
+    runLoader("mmap + from_chars, 1 thread, whitespace", serial, textPath);
+    runLoader("mmap + from_chars, 1 thread, CSV", serial, csvPath);
+    if (loader.threads() > 1) {
+        runLoader("mmap + from_chars, " + to_string(loader.threads()) + " threads, whitespace", loader, textPath);
+        runLoader("mmap + from_chars, " + to_string(loader.threads()) + " threads, CSV", loader, csvPath);
+    }
+
+    {
+        double t = secondsOf([&]() {
+            ColumnFile file(binaryPath);
+            if (file.numRows() != rows) cout << "Unexpected row count." << endl;
+        });
+        ColumnFile file(binaryPath);
+        report("binary columns, open only", t, fileSize(binaryPath), file.numRows(), file.isOpen());
+    }
+    {
+        double sum = 0, expected = 0;
+        for (const vector<double>& column : data)
+            for (double v : column) expected += v;
+        bool exact = false;
+        double t = secondsOf([&]() {
+            ColumnFile file(binaryPath);
+            for (int c = 0; c < file.numColumns(); c++) {
+                const double* x = file.column(c);
+                for (size_t i = 0; i < file.numRows(); i++) sum += x[i];
+            }
+            exact = file.isOpen() && sum == expected;
+            for (int c = 0; exact && c < 4; c++) exact = sameBits(data[c], file.column(c));
+        });
+        report("binary columns, open + read every value", t, fileSize(binaryPath), rows, exact);
+    }
+
+    cout << "\n=== HEADERS, COMMENTS, EMPTY FIELDS AND ERRORS ===" << endl;
+    {
+        const string text = "# sensor log\ntime, value , flag\n\n0, 1.5, 1\n1e-3,,0\n  2e-3 , -inf , +1\n3e-3, 4.9e-324, 1e400\n";
+        NumericTable table = loader.parse(text.data(), text.size());
+        cout << "Columns:";
+        for (const string& name : table.names) cout << " [" << name << "]";
+        cout << ", " << table.rows << " rows" << endl;
+        cout << setprecision(6) << defaultfloat;
+        for (size_t r = 0; r < table.rows; r++) {
+            cout << "  ";
+            for (const vector<double>& column : table.columns) cout << setw(14) << column[r];
+            cout << endl;
+        }
+    }
+    {
+        const string text = ",2,\n3,,4\n";
+        NumericTable table = loader.parse(text.data(), text.size());
+        cout << "\",2,\" and \"3,,4\": " << table.columns.size() << " columns, rows {" << table.columns[0][0] << ", "
+             << table.columns[1][0] << ", " << table.columns[2][0] << "} and {" << table.columns[0][1] << ", "
+             << table.columns[1][1] << ", " << table.columns[2][1] << "}" << endl;
+    }
+    {
+        const string text = "1 2 3\n4 5 6\n7 8\n";
+        NumericTable table = loader.parse(text.data(), text.size());
+        cout << "Short row:        " << (table.ok ? "accepted" : table.error) << endl;
+        const string text2 = "a,b\n1,2\n3,2.5x\n";
+        table = loader.parse(text2.data(), text2.size());
+        cout << "Malformed number: " << (table.ok ? "accepted" : table.error) << endl;
+        const string text3 = "1 2\n3 4 5\n";
+        table = loader.parse(text3.data(), text3.size());
+        cout << "Long row:         " << (table.ok ? "accepted" : table.error) << endl;
+    }
+    {
+        // Writers refuse ragged columns up front and report failed writes (/dev/full fails on every write)
+        vector<vector<double>> ragged = {{1, 2, 3}, {4, 5}};
+        cout << "Ragged columns:   ";
+        ColumnFile::write("ragged.col", ragged);
+        cout << "Full disk:        ";
+        ColumnFile::write("/dev/full", data);
+    }
+
+    remove(textPath.c_str());
+    remove(csvPath.c_str());
+    remove(binaryPath.c_str());
+
+    cout << "\nfrom_chars on the mapped file replaces the stream machinery of >> with a direct scan of the bytes." << endl;
+    cout << "The binary column file needs no parsing: opening it maps the file, and the values are read where they lie." << endl;
+
+    return 0;
+}